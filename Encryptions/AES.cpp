@@ -1,196 +1,203 @@
 #include "AES.h"
 
-void AES::shiftrow(std::vector <uint32_t> & data){
-    std::vector <uint32_t> temp;
-    for(uint8_t x = 0; x < 4; x++){
-        temp.push_back(0);
-        for(uint8_t y = 0; y < 4; y++){
-            temp[x] += ((data[y] >> ((3 - x) << 3)) & 255) << ((3 - y) << 3);
-        }
-    }
-    data = temp;
+namespace {
 
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] = ROL(data[x], x << 3, 32);
-    }
+// multiply by x in GF(2^8)
+uint8_t xtime(const uint8_t a){
+    return (a << 1) ^ ((a & 0x80)?0x1b:0x00);
+}
 
-    temp.clear();
-    for(uint8_t x = 0; x < 4; x++){
-        temp.push_back(0);
-        for(uint8_t y = 0; y < 4; y++){
-            temp[x] += ((data[y] >> ((3 - x) << 3)) & 255) << ((3 - y) << 3);
+// Rijndael finite field multiplication
+// only used to build the tables
+uint8_t GF(uint8_t a, uint8_t b){
+    uint8_t p = 0;
+    while (b){
+        if (b & 1){
+            p ^= a;
         }
+        a = xtime(a);
+        b >>= 1;
     }
-    data = temp;
+    return p;
 }
 
-void AES::invshiftrow(std::vector <uint32_t> & data){
-    std::vector <uint32_t> temp;
-    for(uint8_t x = 0; x < 4; x++){
-        temp.push_back(0);
-        for(uint8_t y = 0; y < 4; y++){
-            temp[x] += ((data[y] >> ((3 - x) << 3)) & 255) << ((3 - y) << 3);
+uint32_t rotr8(const uint32_t x){
+    return (x >> 8) | (x << 24);
+}
+
+// SubBytes + ShiftRows + MixColumns combined into 4 lookups per column
+struct Tables{
+    uint32_t Te[4][256];
+    uint32_t Td[4][256];
+
+    Tables(){
+        for(uint16_t x = 0; x < 256; x++){
+            const uint8_t s = AES_Subbytes[x];
+            const uint8_t i = AES_Inv_Subbytes[x];
+            Te[0][x] = (static_cast <uint32_t> (GF(s, 2)) << 24) | (static_cast <uint32_t> (s) << 16) | (static_cast <uint32_t> (s) << 8) | GF(s, 3);
+            Td[0][x] = (static_cast <uint32_t> (GF(i, 14)) << 24) | (static_cast <uint32_t> (GF(i, 9)) << 16) | (static_cast <uint32_t> (GF(i, 13)) << 8) | GF(i, 11);
+            for(uint8_t t = 1; t < 4; t++){
+                Te[t][x] = rotr8(Te[t - 1][x]);
+                Td[t][x] = rotr8(Td[t - 1][x]);
+            }
         }
     }
-    data = temp;
+};
 
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] = ROR(data[x], x << 3, 32);
-    }
+const Tables & tables(){
+    static const Tables t;
+    return t;
+}
 
-    temp.clear();
-    for(uint8_t x = 0; x < 4; x++){
-        temp.push_back(0);
-        for(uint8_t y = 0; y < 4; y++){
-            temp[x] += ((data[y] >> ((3 - x) << 3)) & 255) << ((3 - y) << 3);
-        }
-    }
-    data = temp;
+uint32_t subword(const uint32_t w){
+    return (static_cast <uint32_t> (AES_Subbytes[w >> 24]) << 24) |
+           (static_cast <uint32_t> (AES_Subbytes[(w >> 16) & 255]) << 16) |
+           (static_cast <uint32_t> (AES_Subbytes[(w >> 8) & 255]) << 8) |
+            static_cast <uint32_t> (AES_Subbytes[w & 255]);
 }
 
-/*
-uint8_t AES::GF(uint8_t a, uint8_t b){
-    //rijndael Finite Field multiplication
-    uint8_t prim = 0x11b;
-    std::string A = makebin(a, 8);
-    std::string B = makebin(b, 8);
-    uint8_t c = 0;
-    for (int i = 7; i >= 0; i--){
-        std::string temp = "";
-        for (int j = 7; i >= 0; i--){
-            temp = str(atoi(a[j]) * atoi(b[i])) + temp;
-        }
-        c ^= int(temp + "0" * (7-i), 2);
+}
+
+void AES::encrypt_block(const uint8_t * in, uint8_t * out) const {
+    const uint32_t (* Te)[256] = tables().Te;
+    const uint32_t * rk = ekeys;
+
+    uint32_t s[4], t[4];
+    for(uint8_t x = 0; x < 4; x++){
+        s[x] = load_big_endian <uint32_t> (in + (x << 2)) ^ rk[x];
     }
-    for i in xrange(15, 8, -1){
-        if makebin(c, i)[0] == "1":{
-            c ^= prim << (i-9);
+
+    for(uint8_t r = 1; r < rounds; r++){
+        rk += 4;
+        for(uint8_t x = 0; x < 4; x++){
+            t[x] = Te[0][s[x] >> 24] ^ Te[1][(s[(x + 1) & 3] >> 16) & 255] ^ Te[2][(s[(x + 2) & 3] >> 8) & 255] ^ Te[3][s[(x + 3) & 3] & 255] ^ rk[x];
         }
+        std::copy(t, t + 4, s);
     }
-    return c
-}
-*/
 
-uint8_t AES::GF(uint8_t a, uint8_t b){
-    /*Rijndael Finite Field multiplication
-    Fast but Vulnerable to Timing Attacks
-    From Wikipedia*/
-    uint8_t prim = 0x1b;
-    uint8_t p = 0, i = 0;
-    while ((i < 8) && (a != 0) and (b != 0)){
-        if (b & 1){
-            p ^= a;
-        }
-        uint8_t hi = a & 0x80;
-        a = (a << 1) & 255;
-        if (hi){
-            a ^= prim;
-        }
-        b >>= 1;
-        i += 1;
+    // last round has no MixColumns
+    rk += 4;
+    for(uint8_t x = 0; x < 4; x++){
+        t[x] = (static_cast <uint32_t> (AES_Subbytes[s[x] >> 24]) << 24) |
+               (static_cast <uint32_t> (AES_Subbytes[(s[(x + 1) & 3] >> 16) & 255]) << 16) |
+               (static_cast <uint32_t> (AES_Subbytes[(s[(x + 2) & 3] >> 8) & 255]) << 8) |
+                static_cast <uint32_t> (AES_Subbytes[s[(x + 3) & 3] & 255]);
+        store_big_endian(t[x] ^ rk[x], out + (x << 2));
     }
-    return p;
 }
 
-void AES::mixcolumns(std::vector <uint32_t> & data){
-    std::vector <uint32_t> temp;
-    for(uint8_t i = 0; i < 4; i++){
-        temp.push_back( ((GF(2, (data[i] >> 24) & 255) ^ GF(3, (data[i] >> 16) & 255) ^ ((data[i] >> 8) & 255) ^ (data[i] & 255)) << 24) +
-                        ((GF(2, (data[i] >> 16) & 255) ^ GF(3, (data[i] >> 8) & 255) ^ (data[i] & 255) ^ ((data[i] >> 24) & 255)) << 16) +
-                        ((GF(2, (data[i] >> 8) & 255) ^ GF(3, data[i] & 255) ^ ((data[i] >> 24) & 255) ^ ((data[i] >> 16) & 255)) << 8 ) +
-                        ((GF(2, data[i] & 255) ^ GF(3, (data[i] >> 24) & 255) ^ ((data[i] >> 16) & 255) ^ ((data[i] >> 8) & 255))));
+void AES::decrypt_block(const uint8_t * in, uint8_t * out) const {
+    // equivalent inverse cipher: dkeys are already reversed and mixed
+    const uint32_t (* Td)[256] = tables().Td;
+    const uint32_t * rk = dkeys;
+
+    uint32_t s[4], t[4];
+    for(uint8_t x = 0; x < 4; x++){
+        s[x] = load_big_endian <uint32_t> (in + (x << 2)) ^ rk[x];
     }
-    data = temp;
-}
 
-void AES::invmixcolumns(std::vector <uint32_t> & data){
-    std::vector <uint32_t> temp;
-    for(uint8_t i = 0; i < 4; i++){
-        temp.push_back( ((GF(14, (data[i] >> 24) & 255) ^ GF(9, (data[i] & 255)) ^ GF(13, (data[i] >> 8) & 255) ^ GF(11, (data[i] >> 16) & 255)) << 24) +
-                        ((GF(14, (data[i] >> 16) & 255) ^ GF(9, (data[i] >> 24) & 255) ^ GF(13, (data[i] & 255)) ^ GF(11, (data[i] >> 8) & 255)) << 16) +
-                        ((GF(14, (data[i] >> 8) & 255) ^ GF(9, (data[i] >> 16) & 255) ^ GF(13, (data[i] >> 24) & 255) ^ GF(11, (data[i] & 255))) << 8 ) +
-                        ((GF(14, (data[i] & 255)) ^ GF(9, (data[i] >> 8) & 255) ^ GF(13, (data[i] >> 16) & 255) ^ GF(11, (data[i] >> 24) & 255))));
+    for(uint8_t r = 1; r < rounds; r++){
+        rk += 4;
+        for(uint8_t x = 0; x < 4; x++){
+            t[x] = Td[0][s[x] >> 24] ^ Td[1][(s[(x + 3) & 3] >> 16) & 255] ^ Td[2][(s[(x + 2) & 3] >> 8) & 255] ^ Td[3][s[(x + 1) & 3] & 255] ^ rk[x];
+        }
+        std::copy(t, t + 4, s);
     }
-    data = temp;
-}
 
-std::string AES::OUT(std::vector <uint32_t> & data){
-    std::string out = "";
+    rk += 4;
     for(uint8_t x = 0; x < 4; x++){
-        out += makehex(data[x], 8);
+        t[x] = (static_cast <uint32_t> (AES_Inv_Subbytes[s[x] >> 24]) << 24) |
+               (static_cast <uint32_t> (AES_Inv_Subbytes[(s[(x + 3) & 3] >> 16) & 255]) << 16) |
+               (static_cast <uint32_t> (AES_Inv_Subbytes[(s[(x + 2) & 3] >> 8) & 255]) << 8) |
+                static_cast <uint32_t> (AES_Inv_Subbytes[s[(x + 1) & 3] & 255]);
+        store_big_endian(t[x] ^ rk[x], out + (x << 2));
     }
-    return unhexlify(out);
 }
 
 AES::AES()
     : SymAlg(),
-      b(0), rounds(0), columns(0),
-      keys()
+      impl(PORTABLE),
+      rounds(0),
+      ekeys(), dkeys(),
+      ni_ekeys(), ni_dkeys(),
+      bs_keys()
 {}
 
-AES::AES(const std::string & KEY)
+AES::AES(const std::string & KEY, const Implementation implementation)
     : AES()
 {
-    setkey(KEY);
+    setkey(KEY, implementation);
 }
 
-void AES::setkey(const std::string & KEY){
+void AES::setkey(const std::string & KEY, const Implementation implementation){
     if (keyset){
         throw std::runtime_error("Error: Key has already been set.");
     }
 
-    uint8_t n = KEY.size();
+    if ((implementation == AESNI) && !AESNI::available()){
+        throw std::runtime_error("Error: AES-NI is not supported by this CPU.");
+    }
+
+    const uint8_t n = KEY.size();
     if ((n != 16) && (n != 24) && (n != 32)){
         throw std::runtime_error("Error: Key size does not fit defined sizes.");
     }
 
     rounds = n / 4 + 6;
-    columns = rounds - 6;
-    b = (rounds + 1) << 4;
-    n >>= 2;
+    const uint8_t columns = n >> 2;
+    const uint8_t words = (rounds + 1) << 2;
 
-    std::vector <uint32_t> key;
+    // key expansion
     for(uint8_t x = 0; x < columns; x++){
-        key.push_back(static_cast <uint32_t> (toint(KEY.substr(x << 2, 4), 256)));
+        ekeys[x] = load_big_endian <uint32_t> (reinterpret_cast <const uint8_t *> (KEY.data()) + (x << 2));
     }
 
-    uint8_t i = 1;
-    while ((key.size() << 2) < b){
-        uint32_t t = ROL(key[key.size() - 1], 8, 32);
-        uint32_t s = 0;
-
-        for(uint8_t j = 0; j < 4; j++){
-            s += AES_Subbytes[static_cast <uint8_t> (t >> (j << 3))] << (j << 3);
+    uint8_t rcon = 1;
+    for(uint8_t x = columns; x < words; x++){
+        uint32_t t = ekeys[x - 1];
+        if ((x % columns) == 0){
+            t = subword((t << 8) | (t >> 24)) ^ (static_cast <uint32_t> (rcon) << 24);
+            rcon = xtime(rcon);
         }
-
-        t = s ^ key[key.size() - n];
-        t ^= ((1 << (i++ - 1)) % 229) << 24;
-        key.push_back(t);
-
-        for(uint8_t j = 0; j < 3; j++){
-            key.push_back(key[key.size() - 1]^ key[key.size() - n]);
+        else if ((columns > 6) && ((x % columns) == 4)){
+            t = subword(t);
         }
+        ekeys[x] = ekeys[x - columns] ^ t;
+    }
 
-        if (n == 8){
-            s = 0;
-            for(uint8_t j = 0; j < 4; j++){
-                s += AES_Subbytes[static_cast <uint8_t> (key[key.size() - 1] >> (j << 3))] << (j << 3);
+    // decryption keys are the encryption keys in reverse order
+    // with InvMixColumns applied to the middle rounds
+    const uint32_t (* Td)[256] = tables().Td;
+    for(uint8_t r = 0; r <= rounds; r++){
+        for(uint8_t x = 0; x < 4; x++){
+            const uint32_t w = ekeys[((rounds - r) << 2) + x];
+            if ((r == 0) || (r == rounds)){
+                dkeys[(r << 2) + x] = w;
+            }
+            else{
+                dkeys[(r << 2) + x] = Td[0][AES_Subbytes[w >> 24]] ^
+                                      Td[1][AES_Subbytes[(w >> 16) & 255]] ^
+                                      Td[2][AES_Subbytes[(w >> 8) & 255]] ^
+                                      Td[3][AES_Subbytes[w & 255]];
             }
-            key.push_back(s ^ key[key.size() - n]);
         }
+    }
 
-        for(uint8_t j = 0; j < 0 * (n == 4) + 2 * (n == 6) + 3 * (n == 8); j++){
-            key.push_back(key[key.size() - 1] ^ key[key.size() - n]);
-        }
+    impl = implementation;
+    if (impl == AUTO){
+        impl = AESNI::available()?AESNI:PORTABLE;
     }
 
-    for(uint8_t j = 0; j < (b >> 4); j++){
-        std::vector <uint32_t> temp;
-        for(uint8_t k = 0; k < 4; k++){
-            temp.push_back(key[(j << 2) + k]);
+    if (impl == AESNI){
+        for(uint8_t x = 0; x < words; x++){
+            store_big_endian(ekeys[x], ni_ekeys + (x << 2));
         }
-        keys.push_back(temp);
+        AESNI::expand_decryption_keys(ni_ekeys, ni_dkeys, rounds);
+    }
+    else if (impl == BITSLICED){
+        AESBitsliced::expand_keys(ekeys, rounds, bs_keys);
     }
+
     keyset = true;
 }
 
@@ -203,40 +210,9 @@ std::string AES::encrypt(const std::string & DATA){
         throw std::runtime_error("Error: Data must be 128 bits long.");
     }
 
-    std::vector <uint32_t> data;
-    for(uint8_t x = 0; x < 4; x++){
-        std::string d = "";
-        for(uint8_t y = 0; y < 4; y++){
-            d += DATA[(x << 2) + y];
-        }
-        data.push_back(static_cast <uint32_t> (toint(d, 256)));
-    }
-
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] ^= keys[0][x];
-    }
-
-    for(uint8_t r = 1; r < rounds; r++){
-        for(uint8_t x = 0; x < 4; x++){
-            data[x] = (AES_Subbytes[data[x] >> 24] << 24) + (AES_Subbytes[(data[x] >> 16) & 255] << 16) + (AES_Subbytes[(data[x] >> 8) & 255] << 8) + AES_Subbytes[data[x] & 255];
-        }
-        shiftrow(data);
-        mixcolumns(data);
-        for(uint8_t x = 0; x < 4; x++){
-            data[x] ^= keys[r][x];
-        }
-    }
-
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] = (AES_Subbytes[data[x] >> 24] << 24) + (AES_Subbytes[(data[x] >> 16) & 255] << 16) + (AES_Subbytes[(data[x] >> 8) & 255] << 8) + AES_Subbytes[data[x] & 255];
-    }
-
-    shiftrow(data);
-
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] ^= keys[rounds][x];
-    }
-    return OUT(data);
+    std::string out(16, 0);
+    encrypt_blocks(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), 1);
+    return out;
 }
 
 std::string AES::decrypt(const std::string & DATA){
@@ -248,48 +224,54 @@ std::string AES::decrypt(const std::string & DATA){
         throw std::runtime_error("Error: Data must be 128 bits long.");
     }
 
-    std::reverse(keys.begin(), keys.end());
-    std::vector <uint32_t> data;
-    for(uint8_t x = 0; x < 4; x++){
-        std::string d = "";
-        for(uint8_t y = 0; y < 4; y++){
-            d += DATA[(x << 2) + y];
-        }
-        data.push_back(static_cast <uint32_t> (toint(d, 256)));
+    std::string out(16, 0);
+    decrypt_blocks(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), 1);
+    return out;
+}
+
+void AES::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
     }
 
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] ^= keys[0][x];
+    if (impl == AESNI){
+        AESNI::encrypt_blocks(ni_ekeys, rounds, in, out, blocks);
+        return;
     }
 
-    for(uint8_t r = 1; r < rounds; r++){
-        invshiftrow(data);
-        for(uint8_t x = 0; x < 4; x++){
-            data[x] = (AES_Inv_Subbytes[data[x] >> 24] << 24) + (AES_Inv_Subbytes[(data[x] >> 16) & 255] << 16) + (AES_Inv_Subbytes[(data[x] >> 8) & 255] << 8) + AES_Inv_Subbytes[data[x] & 255];
-        }
-        for(uint8_t x = 0; x < 4; x++){
-            data[x] ^= keys[r][x];
-        }
-        invmixcolumns(data);
+    if (impl == BITSLICED){
+        AESBitsliced::encrypt_blocks(bs_keys, rounds, in, out, blocks);
+        return;
     }
 
-    invshiftrow(data);
+    for(std::size_t x = 0; x < blocks; x++){
+        encrypt_block(in + (x << 4), out + (x << 4));
+    }
+}
 
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] = (AES_Inv_Subbytes[data[x] >> 24] << 24) + (AES_Inv_Subbytes[(data[x] >> 16) & 255] << 16) + (AES_Inv_Subbytes[(data[x] >> 8) & 255] << 8) + AES_Inv_Subbytes[data[x] & 255];
+void AES::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
     }
 
-    for(uint8_t x = 0; x < 4; x++){
-        data[x] ^= keys[rounds][x];
+    if (impl == AESNI){
+        AESNI::decrypt_blocks(ni_dkeys, rounds, in, out, blocks);
+        return;
     }
 
-    std::reverse(keys.begin(), keys.end());
-    return OUT(data);
+    // there is no bitsliced inverse cipher, so BITSLICED also uses the tables here
+    for(std::size_t x = 0; x < blocks; x++){
+        decrypt_block(in + (x << 4), out + (x << 4));
+    }
 }
 
 unsigned int AES::blocksize() const {
     return 128;
 }
+
+AES::Implementation AES::implementation() const {
+    return impl;
+}
 /*
 // More readable/easier to understand version of AES
 // slightly less efficient though
@@ -33,26 +33,44 @@ THE SOFTWARE.
 #include "SymAlg.h"
 
 #include "AES_Const.h"
+#include "AESBitsliced.h"
+#include "AESNI.h"
 
 class AES : public SymAlg {
+    public:
+        // which code runs the cipher
+        enum Implementation {
+            AUTO,       // AES-NI if the CPU supports it, otherwise PORTABLE
+            PORTABLE,   // T-tables
+            BITSLICED,  // constant time, 8 blocks at a time; decryption uses the T-tables
+            AESNI,
+        };
+
     private:
-        uint8_t b, rounds, columns;
-        std::vector <std::vector <uint32_t> > keys;
+        Implementation impl;
+        uint8_t rounds;
+        uint32_t ekeys[60], dkeys[60];                  // round keys, 4 words per round
+        uint8_t ni_ekeys[15 * 16], ni_dkeys[15 * 16];   // round keys for AES-NI
+        uint64_t bs_keys[AESBitsliced::KEY_WORDS];      // round keys for BITSLICED
 
-        void shiftrow(std::vector <uint32_t> & data);
-        void invshiftrow(std::vector <uint32_t> & data);
-        uint8_t GF(uint8_t a, uint8_t b);
-        void mixcolumns(std::vector <uint32_t> & data);
-        void invmixcolumns(std::vector <uint32_t> & data);
-        std::string OUT(std::vector <uint32_t> & data);
+        void encrypt_block(const uint8_t * in, uint8_t * out) const;
+        void decrypt_block(const uint8_t * in, uint8_t * out) const;
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         AES();
-        AES(const std::string & KEY);
-        void setkey(const std::string & KEY);
+        AES(const std::string & KEY, const Implementation implementation = AUTO);
+        void setkey(const std::string & KEY, const Implementation implementation = AUTO);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
+
+        // implementation selected by setkey
+        Implementation implementation() const;
 };
 
 #endif
@@ -0,0 +1,56 @@
+/*
+AESBitsliced.h
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __AES_BITSLICED__
+#define __AES_BITSLICED__
+
+#include <cstddef>
+#include <cstdint>
+
+// Constant time AES encryption of 8 blocks at a time
+//
+// The state of 8 blocks is held as 8 bit planes of 128 bits (two
+// uint64_t each). Bit k of octet p in plane b is bit b of octet p of
+// block k, so SubBytes becomes a boolean circuit and ShiftRows and
+// MixColumns become fixed octet moves. No table lookups depend on the
+// key or the data.
+//
+// Only the forward cipher is provided, which is all that CFB needs
+// in either direction.
+namespace AESBitsliced {
+    // octets per group of blocks processed together
+    const std::size_t GROUP = 8 * 16;
+
+    // number of uint64_t needed to hold the bitsliced round keys
+    const std::size_t KEY_WORDS = 15 * 8 * 2;
+
+    // rk holds (rounds + 1) * 4 big endian round key words
+    void expand_keys(const uint32_t * rk, const uint8_t rounds, uint64_t * bskeys);
+
+    // in and out may point to the same buffer
+    // a partial group at the end is padded internally
+    void encrypt_blocks(const uint64_t * bskeys, const uint8_t rounds, const uint8_t * in, uint8_t * out, const std::size_t blocks);
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include "AESNI.h"
+
+#include <stdexcept>
+
+#include "../common/CPU.h"
+
+#ifdef CPU_X86
+#define AESNI_SUPPORTED
+#endif
+
+#ifdef AESNI_SUPPORTED
+
+#include <wmmintrin.h>
+
+#define AESNI_TARGET __attribute__((target("aes,sse2")))
+
+namespace AESNI {
+
+bool available(){
+    return OpenPGP::CPU::aes();
+}
+
+AESNI_TARGET
+void expand_decryption_keys(const uint8_t * ekeys, uint8_t * dkeys, const uint8_t rounds){
+    const __m128i * ek = reinterpret_cast <const __m128i *> (ekeys);
+    __m128i * dk = reinterpret_cast <__m128i *> (dkeys);
+
+    _mm_storeu_si128(dk, _mm_loadu_si128(ek + rounds));
+    for(uint8_t r = 1; r < rounds; r++){
+        _mm_storeu_si128(dk + r, _mm_aesimc_si128(_mm_loadu_si128(ek + rounds - r)));
+    }
+    _mm_storeu_si128(dk + rounds, _mm_loadu_si128(ek));
+}
+
+AESNI_TARGET
+void encrypt_blocks(const uint8_t * ekeys, const uint8_t rounds, const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    const __m128i * ek = reinterpret_cast <const __m128i *> (ekeys);
+    __m128i k[15];
+    for(uint8_t r = 0; r <= rounds; r++){
+        k[r] = _mm_loadu_si128(ek + r);
+    }
+
+    const __m128i * src = reinterpret_cast <const __m128i *> (in);
+    __m128i * dst = reinterpret_cast <__m128i *> (out);
+
+    // 4 independent blocks at a time to hide the latency of aesenc
+    std::size_t x = 0;
+    for(; (x + 4) <= blocks; x += 4){
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src + x    ), k[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + x + 1), k[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + x + 2), k[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + x + 3), k[0]);
+        for(uint8_t r = 1; r < rounds; r++){
+            b0 = _mm_aesenc_si128(b0, k[r]);
+            b1 = _mm_aesenc_si128(b1, k[r]);
+            b2 = _mm_aesenc_si128(b2, k[r]);
+            b3 = _mm_aesenc_si128(b3, k[r]);
+        }
+        _mm_storeu_si128(dst + x,     _mm_aesenclast_si128(b0, k[rounds]));
+        _mm_storeu_si128(dst + x + 1, _mm_aesenclast_si128(b1, k[rounds]));
+        _mm_storeu_si128(dst + x + 2, _mm_aesenclast_si128(b2, k[rounds]));
+        _mm_storeu_si128(dst + x + 3, _mm_aesenclast_si128(b3, k[rounds]));
+    }
+
+    for(; x < blocks; x++){
+        __m128i b = _mm_xor_si128(_mm_loadu_si128(src + x), k[0]);
+        for(uint8_t r = 1; r < rounds; r++){
+            b = _mm_aesenc_si128(b, k[r]);
+        }
+        _mm_storeu_si128(dst + x, _mm_aesenclast_si128(b, k[rounds]));
+    }
+}
+
+AESNI_TARGET
+void decrypt_blocks(const uint8_t * dkeys, const uint8_t rounds, const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    const __m128i * dk = reinterpret_cast <const __m128i *> (dkeys);
+    __m128i k[15];
+    for(uint8_t r = 0; r <= rounds; r++){
+        k[r] = _mm_loadu_si128(dk + r);
+    }
+
+    const __m128i * src = reinterpret_cast <const __m128i *> (in);
+    __m128i * dst = reinterpret_cast <__m128i *> (out);
+
+    std::size_t x = 0;
+    for(; (x + 4) <= blocks; x += 4){
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src + x    ), k[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + x + 1), k[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + x + 2), k[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + x + 3), k[0]);
+        for(uint8_t r = 1; r < rounds; r++){
+            b0 = _mm_aesdec_si128(b0, k[r]);
+            b1 = _mm_aesdec_si128(b1, k[r]);
+            b2 = _mm_aesdec_si128(b2, k[r]);
+            b3 = _mm_aesdec_si128(b3, k[r]);
+        }
+        _mm_storeu_si128(dst + x,     _mm_aesdeclast_si128(b0, k[rounds]));
+        _mm_storeu_si128(dst + x + 1, _mm_aesdeclast_si128(b1, k[rounds]));
+        _mm_storeu_si128(dst + x + 2, _mm_aesdeclast_si128(b2, k[rounds]));
+        _mm_storeu_si128(dst + x + 3, _mm_aesdeclast_si128(b3, k[rounds]));
+    }
+
+    for(; x < blocks; x++){
+        __m128i b = _mm_xor_si128(_mm_loadu_si128(src + x), k[0]);
+        for(uint8_t r = 1; r < rounds; r++){
+            b = _mm_aesdec_si128(b, k[r]);
+        }
+        _mm_storeu_si128(dst + x, _mm_aesdeclast_si128(b, k[rounds]));
+    }
+}
+
+}
+
+#else
+
+namespace AESNI {
+
+bool available(){
+    return false;
+}
+
+void expand_decryption_keys(const uint8_t *, uint8_t *, const uint8_t){
+    throw std::runtime_error("Error: AES-NI is not supported on this platform.");
+}
+
+void encrypt_blocks(const uint8_t *, const uint8_t, const uint8_t *, uint8_t *, const std::size_t){
+    throw std::runtime_error("Error: AES-NI is not supported on this platform.");
+}
+
+void decrypt_blocks(const uint8_t *, const uint8_t, const uint8_t *, uint8_t *, const std::size_t){
+    throw std::runtime_error("Error: AES-NI is not supported on this platform.");
+}
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+AESNI.h
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __AESNI__
+#define __AESNI__
+
+#include <cstddef>
+#include <cstdint>
+
+// AES using the x86 AES-NI instructions
+//
+// Round keys are the 16 octet big endian round keys produced by the
+// normal AES key schedule, laid out back to back. Decryption uses the
+// "equivalent inverse cipher", whose keys come from expand_decryption_keys.
+//
+// Everything here only works if available() returns true.
+namespace AESNI {
+    // whether or not the current CPU supports AES-NI
+    bool available();
+
+    // ekeys and dkeys hold (rounds + 1) * 16 octets
+    void expand_decryption_keys(const uint8_t * ekeys, uint8_t * dkeys, const uint8_t rounds);
+
+    // in and out may point to the same buffer
+    void encrypt_blocks(const uint8_t * ekeys, const uint8_t rounds, const uint8_t * in, uint8_t * out, const std::size_t blocks);
+    void decrypt_blocks(const uint8_t * dkeys, const uint8_t rounds, const uint8_t * in, uint8_t * out, const std::size_t blocks);
+}
+
+#endif
@@ -4,30 +4,23 @@ uint32_t Blowfish::f(const uint32_t & left){
     return ((((sbox[0][ left >> 24] + sbox[1][(left >> 16) & 255]) & mod32) ^ sbox[2][(left >> 8) & 255]) + sbox[3][left & 255]) & mod32;
 }
 
-std::string Blowfish::run(const std::string & data){
-    if (!keyset ^ settingkey){
-        throw std::runtime_error("Error: Key has not been set");
-    }
-
-    if (data.size() != 8){
-        throw std::runtime_error("Error: Data must be 64 bits in length.");
-    }
-
-    uint32_t left = toint(data.substr(0, 4), 256), right = toint(data.substr(4, 4), 256);
+void Blowfish::run(const uint8_t * in, uint8_t * out, const bool enc){
+    // decryption uses the p-array in reverse order
+    uint32_t left = load_big_endian <uint32_t> (in), right = load_big_endian <uint32_t> (in + 4);
     for(uint8_t i = 0; i < 16; i++){
-        left ^= p[i];
+        left ^= p[enc?i:(17 - i)];
         right ^= f(left);
         std::swap(left,right);
     }
     //std::swap(right, left);       // Save 513 swaps
-    right ^= p[17];
-    left ^= p[16];
-    return unhexlify(makehex(right, 8) + makehex(left, 8));
+    right ^= p[enc?17:0];
+    left ^= p[enc?16:1];
+    store_big_endian(right, out);
+    store_big_endian(left, out + 4);
 }
 
 Blowfish::Blowfish()
     : SymAlg(),
-      settingkey(true),
       p(), sbox()
 {}
 
@@ -67,37 +60,71 @@ void Blowfish::setkey(const std::string & KEY){
         p[x] ^= static_cast <uint32_t> (toint(key.substr(x << 2, 4), 256));
     }
 
-    std::string ini(8, 0);
+    uint8_t ini[8] = {0};
     for(uint8_t x = 0; x < 9; x++){
-        std::string NEW = run(ini);
-        ini = NEW;
-        p[x << 1] = toint(NEW.substr(0, 4), 256);
-        p[(x << 1) + 1] = toint(NEW.substr(4, 4), 256);
+        run(ini, ini, true);
+        p[x << 1] = load_big_endian <uint32_t> (ini);
+        p[(x << 1) + 1] = load_big_endian <uint32_t> (ini + 4);
     }
 
     for(uint8_t x = 0; x < 4; x++){
         for(uint8_t y = 0; y < 128; y++){
-            std::string NEW = run(ini);
-            ini = NEW;
-            sbox[x][y << 1] = toint(NEW.substr(0, 4), 256);
-            sbox[x][(y << 1) + 1] = toint(NEW.substr(4, 4), 256);
+            run(ini, ini, true);
+            sbox[x][y << 1] = load_big_endian <uint32_t> (ini);
+            sbox[x][(y << 1) + 1] = load_big_endian <uint32_t> (ini + 4);
         }
     }
     keyset = true;
-    settingkey = false;
 }
 
 std::string Blowfish::encrypt(const std::string & DATA){
-    return run(DATA);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits in length.");
+    }
+
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), true);
+    return out;
 }
 
 std::string Blowfish::decrypt(const std::string & DATA){
-    std::reverse(p, p + 18);
-    std::string out = run(DATA);
-    std::reverse(p, p + 18);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits in length.");
+    }
+
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), false);
     return out;
 }
 
+void Blowfish::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), true);
+    }
+}
+
+void Blowfish::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), false);
+    }
+}
+
 unsigned int Blowfish::blocksize() const {
     return 64;
 }
@@ -34,17 +34,21 @@ THE SOFTWARE.
 
 class Blowfish : public SymAlg {
     private:
-        bool settingkey;
         uint32_t p[18], sbox[4][512];        //Taken from a C file from the Blowfish site
         uint32_t f(const uint32_t & left);
-        std::string run(const std::string & data);
+        void run(const uint8_t * in, uint8_t * out, const bool enc);
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         Blowfish();
         Blowfish(const std::string & KEY);
         void setkey(const std::string & KEY);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
 };
 
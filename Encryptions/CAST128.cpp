@@ -29,15 +29,9 @@ uint32_t CAST128::F(const uint8_t & round, const uint32_t & D, const uint32_t &
     return f;
 }
 
-std::string CAST128::run(const std::string & DATA, const uint8_t start, const uint8_t stop, const uint8_t step){
-    if (!keyset){
-        throw std::runtime_error("Error: Key has not been set.");
-    }
-    if (DATA.size() != 8){
-        throw std::runtime_error("Error: Data must be 64 bits long.");
-    }
-    uint32_t left = toint(DATA.substr(0, 4), 256);
-    uint32_t right = toint(DATA.substr(4, 4), 256);
+void CAST128::run(const uint8_t * in, uint8_t * out, const uint8_t start, const uint8_t stop, const uint8_t step){
+    uint32_t left = load_big_endian <uint32_t> (in);
+    uint32_t right = load_big_endian <uint32_t> (in + 4);
     uint8_t i = start;
     while (i != stop){
         uint32_t temp = right;
@@ -45,7 +39,8 @@ std::string CAST128::run(const std::string & DATA, const uint8_t start, const ui
         left = temp;
         i += step;
     }
-    return unhexlify(makehex(right, 8) + makehex(left, 8));
+    store_big_endian(right, out);
+    store_big_endian(left, out + 4);
 }
 
 CAST128::CAST128()
@@ -189,11 +184,51 @@ void CAST128::setkey(std::string KEY){
 }
 
 std::string CAST128::encrypt(const std::string & DATA){
-    return run(DATA, 1, rounds + 1, 1);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits long.");
+    }
+
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), 1, rounds + 1, 1);
+    return out;
 }
 
 std::string CAST128::decrypt(const std::string & DATA){
-    return run(DATA, rounds, 0, -1);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits long.");
+    }
+
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), rounds, 0, -1);
+    return out;
+}
+
+void CAST128::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), 1, rounds + 1, 1);
+    }
+}
+
+void CAST128::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), rounds, 0, -1);
+    }
 }
 
 unsigned int CAST128::blocksize() const {
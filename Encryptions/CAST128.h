@@ -37,14 +37,19 @@ class CAST128 : public SymAlg {
         uint8_t rounds, kr[16];
         uint32_t km[16];
         uint32_t F(const uint8_t & round, const uint32_t & D, const uint32_t & Kmi, const uint8_t & Kri);
-        std::string run(const std::string & data, const uint8_t start, const uint8_t stop, const uint8_t step);
+        void run(const uint8_t * in, uint8_t * out, const uint8_t start, const uint8_t stop, const uint8_t step);
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         CAST128();
         CAST128(const std::string & KEY);
         void setkey(std::string KEY);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
 };
 
@@ -15,196 +15,183 @@ uint8_t Camellia::SBOX(const uint8_t s, const uint8_t value){
     }
 }
 
-std::string Camellia::FL(const std::string & FL_IN, const std::string & KE){
-    std::string x1 = FL_IN.substr(0, 4);
-    std::string x2 = FL_IN.substr(4, 4);
-    const std::string k1 = KE.substr(0, 4);
-    const std::string k2 = KE.substr(4, 4);
-    x2 = xor_strings(x2, ROL(and_strings(x1, k1), 1));
-    x1 = xor_strings(x1, or_strings(x2, k2));
-    return x1 + x2;
+uint64_t Camellia::FL(const uint64_t FL_IN, const uint64_t KE){
+    uint32_t x1 = FL_IN >> 32;
+    uint32_t x2 = FL_IN & mod32;
+    const uint32_t k1 = KE >> 32;
+    const uint32_t k2 = KE & mod32;
+    x2 ^= ROL(x1 & k1, 1, 32);
+    x1 ^= x2 | k2;
+    return (static_cast <uint64_t> (x1) << 32) | x2;
 }
 
-std::string Camellia::FLINV(const std::string & FLINV_IN, const std::string & KE){
-    std::string y1 = FLINV_IN.substr(0, 4);
-    std::string y2 = FLINV_IN.substr(4, 4);
-    const std::string k1 = KE.substr(0, 4);
-    const std::string k2 = KE.substr(4, 4);
-    y1 = xor_strings(y1, or_strings(y2, k2));
-    y2 = xor_strings(y2, ROL(and_strings(y1, k1), 1));
-    return y1 + y2;
+uint64_t Camellia::FLINV(const uint64_t FLINV_IN, const uint64_t KE){
+    uint32_t y1 = FLINV_IN >> 32;
+    uint32_t y2 = FLINV_IN & mod32;
+    const uint32_t k1 = KE >> 32;
+    const uint32_t k2 = KE & mod32;
+    y1 ^= y2 | k2;
+    y2 ^= ROL(y1 & k1, 1, 32);
+    return (static_cast <uint64_t> (y1) << 32) | y2;
 }
 
-std::string Camellia::F(const std::string & F_IN, const std::string & KE){
-    const std::string x = xor_strings(F_IN, KE);
-    const uint8_t t1 = SBOX(1, x[0]);
-    const uint8_t t2 = SBOX(2, x[1]);
-    const uint8_t t3 = SBOX(3, x[2]);
-    const uint8_t t4 = SBOX(4, x[3]);
-    const uint8_t t5 = SBOX(2, x[4]);
-    const uint8_t t6 = SBOX(3, x[5]);
-    const uint8_t t7 = SBOX(4, x[6]);
-    const uint8_t t8 = SBOX(1, x[7]);
-    const uint8_t y1 = t1 ^ t3 ^ t4 ^ t6 ^ t7 ^ t8;
-    const uint8_t y2 = t1 ^ t2 ^ t4 ^ t5 ^ t7 ^ t8;
-    const uint8_t y3 = t1 ^ t2 ^ t3 ^ t5 ^ t6 ^ t8;
-    const uint8_t y4 = t2 ^ t3 ^ t4 ^ t5 ^ t6 ^ t7;
-    const uint8_t y5 = t1 ^ t2 ^ t6 ^ t7 ^ t8;
-    const uint8_t y6 = t2 ^ t3 ^ t5 ^ t7 ^ t8;
-    const uint8_t y7 = t3 ^ t4 ^ t5 ^ t6 ^ t8;
-    const uint8_t y8 = t1 ^ t4 ^ t5 ^ t6 ^ t7;
-    return std::string(1, y1) +
-           std::string(1, y2) +
-           std::string(1, y3) +
-           std::string(1, y4) +
-           std::string(1, y5) +
-           std::string(1, y6) +
-           std::string(1, y7) +
-           std::string(1, y8);
+uint64_t Camellia::F(const uint64_t F_IN, const uint64_t KE){
+    const uint64_t x = F_IN ^ KE;
+    const uint8_t t1 = SBOX(1, byte(x, 7));
+    const uint8_t t2 = SBOX(2, byte(x, 6));
+    const uint8_t t3 = SBOX(3, byte(x, 5));
+    const uint8_t t4 = SBOX(4, byte(x, 4));
+    const uint8_t t5 = SBOX(2, byte(x, 3));
+    const uint8_t t6 = SBOX(3, byte(x, 2));
+    const uint8_t t7 = SBOX(4, byte(x, 1));
+    const uint8_t t8 = SBOX(1, byte(x, 0));
+    const uint64_t y1 = t1 ^ t3 ^ t4 ^ t6 ^ t7 ^ t8;
+    const uint64_t y2 = t1 ^ t2 ^ t4 ^ t5 ^ t7 ^ t8;
+    const uint64_t y3 = t1 ^ t2 ^ t3 ^ t5 ^ t6 ^ t8;
+    const uint64_t y4 = t2 ^ t3 ^ t4 ^ t5 ^ t6 ^ t7;
+    const uint64_t y5 = t1 ^ t2 ^ t6 ^ t7 ^ t8;
+    const uint64_t y6 = t2 ^ t3 ^ t5 ^ t7 ^ t8;
+    const uint64_t y7 = t3 ^ t4 ^ t5 ^ t6 ^ t8;
+    const uint64_t y8 = t1 ^ t4 ^ t5 ^ t6 ^ t7;
+    return (y1 << 56) | (y2 << 48) | (y3 << 40) | (y4 << 32) |
+           (y5 << 24) | (y6 << 16) | (y7 <<  8) |  y8;
 }
 
-std::string Camellia::run(const std::string & data){
-    if (!keyset){
-        throw std::runtime_error("Error: Key has not been set.");
-    }
-
-    if (data.size() != 16){
-        throw std::runtime_error("Error: Data must be 128 bits in length.");
-    }
-
-    std::string D1 = data.substr(0, 8);
-    std::string D2 = data.substr(8, 8);
+void Camellia::run(const uint8_t * in, uint8_t * out, const std::vector <uint64_t> & keys){
+    uint64_t D1 = load_big_endian <uint64_t> (in);
+    uint64_t D2 = load_big_endian <uint64_t> (in + 8);
     if (keysize == 16){
-        const std::string & kw1 = keys[0];
-        const std::string & kw2 = keys[1];
-        const std::string & k1  = keys[2];
-        const std::string & k2  = keys[3];
-        const std::string & k3  = keys[4];
-        const std::string & k4  = keys[5];
-        const std::string & k5  = keys[6];
-        const std::string & k6  = keys[7];
-        const std::string & k7  = keys[8];
-        const std::string & k8  = keys[9];
-        const std::string & k9  = keys[10];
-        const std::string & ke1 = keys[11];
-        const std::string & ke2 = keys[12];
-        const std::string & ke3 = keys[13];
-        const std::string & ke4 = keys[14];
-        const std::string & k10 = keys[15];
-        const std::string & k11 = keys[16];
-        const std::string & k12 = keys[17];
-        const std::string & k13 = keys[18];
-        const std::string & k14 = keys[19];
-        const std::string & k15 = keys[20];
-        const std::string & k16 = keys[21];
-        const std::string & k17 = keys[22];
-        const std::string & k18 = keys[23];
-        const std::string & kw4 = keys[24];
-        const std::string & kw3 = keys[25];
-        D1 = xor_strings(D1, kw1);
-        D2 = xor_strings(D2, kw2);
-        D2 = xor_strings(D2, F(D1, k1));
-        D1 = xor_strings(D1, F(D2, k2));
-        D2 = xor_strings(D2, F(D1, k3));
-        D1 = xor_strings(D1, F(D2, k4));
-        D2 = xor_strings(D2, F(D1, k5));
-        D1 = xor_strings(D1, F(D2, k6));
+        const uint64_t & kw1 = keys[0];
+        const uint64_t & kw2 = keys[1];
+        const uint64_t & k1  = keys[2];
+        const uint64_t & k2  = keys[3];
+        const uint64_t & k3  = keys[4];
+        const uint64_t & k4  = keys[5];
+        const uint64_t & k5  = keys[6];
+        const uint64_t & k6  = keys[7];
+        const uint64_t & k7  = keys[8];
+        const uint64_t & k8  = keys[9];
+        const uint64_t & k9  = keys[10];
+        const uint64_t & ke1 = keys[11];
+        const uint64_t & ke2 = keys[12];
+        const uint64_t & ke3 = keys[13];
+        const uint64_t & ke4 = keys[14];
+        const uint64_t & k10 = keys[15];
+        const uint64_t & k11 = keys[16];
+        const uint64_t & k12 = keys[17];
+        const uint64_t & k13 = keys[18];
+        const uint64_t & k14 = keys[19];
+        const uint64_t & k15 = keys[20];
+        const uint64_t & k16 = keys[21];
+        const uint64_t & k17 = keys[22];
+        const uint64_t & k18 = keys[23];
+        const uint64_t & kw4 = keys[24];
+        const uint64_t & kw3 = keys[25];
+        D1 ^= kw1;
+        D2 ^= kw2;
+        D2 ^= F(D1, k1);
+        D1 ^= F(D2, k2);
+        D2 ^= F(D1, k3);
+        D1 ^= F(D2, k4);
+        D2 ^= F(D1, k5);
+        D1 ^= F(D2, k6);
         D1 = FL(D1, ke1);
         D2 = FLINV(D2, ke2);
-        D2 = xor_strings(D2, F(D1, k7));
-        D1 = xor_strings(D1, F(D2, k8));
-        D2 = xor_strings(D2, F(D1, k9));
-        D1 = xor_strings(D1, F(D2, k10));
-        D2 = xor_strings(D2, F(D1, k11));
-        D1 = xor_strings(D1, F(D2, k12));
+        D2 ^= F(D1, k7);
+        D1 ^= F(D2, k8);
+        D2 ^= F(D1, k9);
+        D1 ^= F(D2, k10);
+        D2 ^= F(D1, k11);
+        D1 ^= F(D2, k12);
         D1 = FL(D1, ke3);
         D2 = FLINV(D2, ke4);
-        D2 = xor_strings(D2, F(D1, k13));
-        D1 = xor_strings(D1, F(D2, k14));
-        D2 = xor_strings(D2, F(D1, k15));
-        D1 = xor_strings(D1, F(D2, k16));
-        D2 = xor_strings(D2, F(D1, k17));
-        D1 = xor_strings(D1, F(D2, k18));
-        D2 = xor_strings(D2, kw3);
-        D1 = xor_strings(D1, kw4);
+        D2 ^= F(D1, k13);
+        D1 ^= F(D2, k14);
+        D2 ^= F(D1, k15);
+        D1 ^= F(D2, k16);
+        D2 ^= F(D1, k17);
+        D1 ^= F(D2, k18);
+        D2 ^= kw3;
+        D1 ^= kw4;
     }
     else{
-        const std::string & kw1 = keys[0];
-        const std::string & kw2 = keys[1];
-        const std::string & k1  = keys[2];
-        const std::string & k2  = keys[3];
-        const std::string & k3  = keys[4];
-        const std::string & k4  = keys[5];
-        const std::string & k5  = keys[6];
-        const std::string & k6  = keys[7];
-        const std::string & k7  = keys[8];
-        const std::string & k8  = keys[9];
-        const std::string & k9  = keys[10];
-        const std::string & k10 = keys[11];
-        const std::string & k11 = keys[12];
-        const std::string & k12 = keys[13];
-        const std::string & ke1 = keys[14];
-        const std::string & ke2 = keys[15];
-        const std::string & ke3 = keys[16];
-        const std::string & ke4 = keys[17];
-        const std::string & ke5 = keys[18];
-        const std::string & ke6 = keys[19];
-        const std::string & k13 = keys[20];
-        const std::string & k14 = keys[21];
-        const std::string & k15 = keys[22];
-        const std::string & k16 = keys[23];
-        const std::string & k17 = keys[24];
-        const std::string & k18 = keys[25];
-        const std::string & k19 = keys[26];
-        const std::string & k20 = keys[27];
-        const std::string & k21 = keys[28];
-        const std::string & k22 = keys[29];
-        const std::string & k23 = keys[30];
-        const std::string & k24 = keys[31];
-        const std::string & kw4 = keys[32];
-        const std::string & kw3 = keys[33];
-        D1 = xor_strings(D1, kw1);
-        D2 = xor_strings(D2, kw2);
-        D2 = xor_strings(D2, F(D1, k1));
-        D1 = xor_strings(D1, F(D2, k2));
-        D2 = xor_strings(D2, F(D1, k3));
-        D1 = xor_strings(D1, F(D2, k4));
-        D2 = xor_strings(D2, F(D1, k5));
-        D1 = xor_strings(D1, F(D2, k6));
+        const uint64_t & kw1 = keys[0];
+        const uint64_t & kw2 = keys[1];
+        const uint64_t & k1  = keys[2];
+        const uint64_t & k2  = keys[3];
+        const uint64_t & k3  = keys[4];
+        const uint64_t & k4  = keys[5];
+        const uint64_t & k5  = keys[6];
+        const uint64_t & k6  = keys[7];
+        const uint64_t & k7  = keys[8];
+        const uint64_t & k8  = keys[9];
+        const uint64_t & k9  = keys[10];
+        const uint64_t & k10 = keys[11];
+        const uint64_t & k11 = keys[12];
+        const uint64_t & k12 = keys[13];
+        const uint64_t & ke1 = keys[14];
+        const uint64_t & ke2 = keys[15];
+        const uint64_t & ke3 = keys[16];
+        const uint64_t & ke4 = keys[17];
+        const uint64_t & ke5 = keys[18];
+        const uint64_t & ke6 = keys[19];
+        const uint64_t & k13 = keys[20];
+        const uint64_t & k14 = keys[21];
+        const uint64_t & k15 = keys[22];
+        const uint64_t & k16 = keys[23];
+        const uint64_t & k17 = keys[24];
+        const uint64_t & k18 = keys[25];
+        const uint64_t & k19 = keys[26];
+        const uint64_t & k20 = keys[27];
+        const uint64_t & k21 = keys[28];
+        const uint64_t & k22 = keys[29];
+        const uint64_t & k23 = keys[30];
+        const uint64_t & k24 = keys[31];
+        const uint64_t & kw4 = keys[32];
+        const uint64_t & kw3 = keys[33];
+        D1 ^= kw1;
+        D2 ^= kw2;
+        D2 ^= F(D1, k1);
+        D1 ^= F(D2, k2);
+        D2 ^= F(D1, k3);
+        D1 ^= F(D2, k4);
+        D2 ^= F(D1, k5);
+        D1 ^= F(D2, k6);
         D1 = FL(D1, ke1);
         D2 = FLINV(D2, ke2);
-        D2 = xor_strings(D2, F(D1, k7));
-        D1 = xor_strings(D1, F(D2, k8));
-        D2 = xor_strings(D2, F(D1, k9));
-        D1 = xor_strings(D1, F(D2, k10));
-        D2 = xor_strings(D2, F(D1, k11));
-        D1 = xor_strings(D1, F(D2, k12));
+        D2 ^= F(D1, k7);
+        D1 ^= F(D2, k8);
+        D2 ^= F(D1, k9);
+        D1 ^= F(D2, k10);
+        D2 ^= F(D1, k11);
+        D1 ^= F(D2, k12);
         D1 = FL(D1, ke3);
         D2 = FLINV(D2, ke4);
-        D2 = xor_strings(D2, F(D1, k13));
-        D1 = xor_strings(D1, F(D2, k14));
-        D2 = xor_strings(D2, F(D1, k15));
-        D1 = xor_strings(D1, F(D2, k16));
-        D2 = xor_strings(D2, F(D1, k17));
-        D1 = xor_strings(D1, F(D2, k18));
+        D2 ^= F(D1, k13);
+        D1 ^= F(D2, k14);
+        D2 ^= F(D1, k15);
+        D1 ^= F(D2, k16);
+        D2 ^= F(D1, k17);
+        D1 ^= F(D2, k18);
         D1 = FL(D1, ke5);
         D2 = FLINV(D2, ke6);
-        D2 = xor_strings(D2, F(D1, k19));
-        D1 = xor_strings(D1, F(D2, k20));
-        D2 = xor_strings(D2, F(D1, k21));
-        D1 = xor_strings(D1, F(D2, k22));
-        D2 = xor_strings(D2, F(D1, k23));
-        D1 = xor_strings(D1, F(D2, k24));
-        D2 = xor_strings(D2, kw3);
-        D1 = xor_strings(D1, kw4);
+        D2 ^= F(D1, k19);
+        D1 ^= F(D2, k20);
+        D2 ^= F(D1, k21);
+        D1 ^= F(D2, k22);
+        D2 ^= F(D1, k23);
+        D1 ^= F(D2, k24);
+        D2 ^= kw3;
+        D1 ^= kw4;
     }
-    return D2 + D1;
+    store_big_endian(D2, out);
+    store_big_endian(D1, out + 8);
 }
 
 Camellia::Camellia()
     : SymAlg(),
     keysize(0),
-    keys()
+    ekeys(), dkeys()
 {}
 
 Camellia::Camellia(const std::string & KEY) 
@@ -238,24 +225,29 @@ void Camellia::setkey(const std::string & KEY){
     }
 
     const std::string D = xor_strings(KL, KR);
-    std::string D1 = D.substr(0, 8);
-    std::string D2 = D.substr(8, 8);
+    uint64_t D1 = load_big_endian <uint64_t> (reinterpret_cast <const uint8_t *> (D.data()));
+    uint64_t D2 = load_big_endian <uint64_t> (reinterpret_cast <const uint8_t *> (D.data()) + 8);
 
-    D2 = xor_strings(D2, F(D1, Camellia_Sigma[0]));
-    D1 = xor_strings(D1, F(D2, Camellia_Sigma[1]));
-    D1 = xor_strings(D1, KL.substr(0, 8));
-    D2 = xor_strings(D2, KL.substr(8, 8));
-    D2 = xor_strings(D2, F(D1, Camellia_Sigma[2]));
-    D1 = xor_strings(D1, F(D2, Camellia_Sigma[3]));
-    std::string KA = D1 + D2;
+    D2 ^= F(D1, Camellia_Sigma[0]);
+    D1 ^= F(D2, Camellia_Sigma[1]);
+    D1 ^= load_big_endian <uint64_t> (reinterpret_cast <const uint8_t *> (KL.data()));
+    D2 ^= load_big_endian <uint64_t> (reinterpret_cast <const uint8_t *> (KL.data()) + 8);
+    D2 ^= F(D1, Camellia_Sigma[2]);
+    D1 ^= F(D2, Camellia_Sigma[3]);
+    std::string KA(16, 0);
+    store_big_endian(D1, reinterpret_cast <uint8_t *> (&KA[0]));
+    store_big_endian(D2, reinterpret_cast <uint8_t *> (&KA[8]));
 
     const std::string AR = xor_strings(KA, KR);
-    D1 = AR.substr(0, 8);
-    D2 = AR.substr(8, 8);
-    D2 = xor_strings(D2, F(D1, Camellia_Sigma[4]));
-    D1 = xor_strings(D1, F(D2, Camellia_Sigma[5]));
-    std::string KB = D1 + D2;
+    D1 = load_big_endian <uint64_t> (reinterpret_cast <const uint8_t *> (AR.data()));
+    D2 = load_big_endian <uint64_t> (reinterpret_cast <const uint8_t *> (AR.data()) + 8);
+    D2 ^= F(D1, Camellia_Sigma[4]);
+    D1 ^= F(D2, Camellia_Sigma[5]);
+    std::string KB(16, 0);
+    store_big_endian(D1, reinterpret_cast <uint8_t *> (&KB[0]));
+    store_big_endian(D2, reinterpret_cast <uint8_t *> (&KB[8]));
 
+    std::vector <std::string> keys;
     std::string T;
     if (keysize == 16){
         T = ROL(KL, 0);
@@ -353,20 +345,62 @@ void Camellia::setkey(const std::string & KEY){
         keys.push_back(T.substr(0, 8)); // kw3
     }
 
+    for(std::string const & key : keys){
+        ekeys.push_back(load_big_endian <uint64_t> (reinterpret_cast <const uint8_t *> (key.data())));
+    }
+    dkeys.assign(ekeys.rbegin(), ekeys.rend());
+
     keyset = true;
 }
 
 std::string Camellia::encrypt(const std::string & DATA){
-    return run(DATA);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 16){
+        throw std::runtime_error("Error: Data must be 128 bits in length.");
+    }
+
+    std::string out(16, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), ekeys);
+    return out;
 }
 
 std::string Camellia::decrypt(const std::string & DATA){
-    std::reverse(keys.begin(), keys.end());
-    std::string out = run(DATA);
-    std::reverse(keys.begin(), keys.end());
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 16){
+        throw std::runtime_error("Error: Data must be 128 bits in length.");
+    }
+
+    std::string out(16, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), dkeys);
     return out;
 }
 
+void Camellia::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 4), out + (x << 4), ekeys);
+    }
+}
+
+void Camellia::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 4), out + (x << 4), dkeys);
+    }
+}
+
 unsigned int Camellia::blocksize() const {
     return 128;
 }
@@ -41,19 +41,24 @@ class Camellia : public SymAlg {
 
     private:
         uint16_t keysize;
-        std::vector <std::string> keys;
+        std::vector <uint64_t> ekeys, dkeys;    // decryption uses the subkeys in reverse order
         uint8_t  SBOX(const uint8_t s, const uint8_t value);
-        std::string FL(const std::string & FL_IN, const std::string & KE);
-        std::string FLINV(const std::string & FLINV_IN, const std::string & KE);
-        std::string F(const std::string & F_IN, const std::string & KE);
-        std::string run(const std::string & data);
+        uint64_t FL(const uint64_t FL_IN, const uint64_t KE);
+        uint64_t FLINV(const uint64_t FLINV_IN, const uint64_t KE);
+        uint64_t F(const uint64_t F_IN, const uint64_t KE);
+        void run(const uint8_t * in, uint8_t * out, const std::vector <uint64_t> & keys);
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         Camellia();
         Camellia(const std::string & KEY);
         void setkey(const std::string & KEY);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
 };
 
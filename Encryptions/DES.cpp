@@ -1,72 +1,40 @@
 #include "DES.h"
 
-std::string DES::run(const std::string & DATA){
-    if (!keyset){
-        throw std::runtime_error("Error: Key has not been set.");
-    }
-
-    if (DATA.size() != 8){
-        throw std::runtime_error("Error: Data must be 64 bits in length.");
+// move the bits of in around according to a table of 1-indexed bit positions (counted from the top)
+uint64_t DES::permute(const uint64_t in, const uint8_t * table, const uint8_t in_bits, const uint8_t out_bits){
+    uint64_t out = 0;
+    for(uint8_t x = 0; x < out_bits; x++){
+        out = (out << 1) | ((in >> (in_bits - table[x])) & 1);
     }
+    return out;
+}
 
-    std::string data = "", temp = "";
-    for(uint8_t x = 0; x < 8; x++){
-        data += makebin(static_cast <uint8_t> (DATA[x]), 8);
-    }
+void DES::run(const uint8_t * in, uint8_t * out, const bool enc){
     // IP
-    for(uint8_t x = 0; x < 64; x++){
-        temp += data[DES_IP[x] - 1];
-    }
-    data = temp;
-    for(uint8_t x = 0; x < 16; x++){
-        // split left and right and duplicate right
-        std::string left = data.substr(0, 32);
-        std::string right = data.substr(32, 32);
-        std::string old_right = right;
-
-        // expand right side
-        uint64_t t = 0;
-        temp = "";
-        for(uint8_t y = 0; y < 48; y++){
-            temp += right[DES_EX[y] - 1];
-        }
-        t = toint(temp, 2);
+    const uint64_t data = permute(load_big_endian <uint64_t> (in), DES_IP, 64, 64);
 
-        // expanded_right xor key
-        right = makebin(t ^ keys[x], 48);
+    // split left and right
+    uint32_t left = data >> 32;
+    uint32_t right = data & mod32;
+    for(uint8_t x = 0; x < 16; x++){
+        // expand right side and xor with key (keys are used in reverse order to decrypt)
+        const uint64_t t = permute(right, DES_EX, 32, 48) ^ keys[enc?x:(15 - x)];
 
-        // split right into 8 parts
-        std::string RIGHT[8];
-        for(uint8_t y = 0; y < 8; y++){
-            RIGHT[y] = right.substr(6 * y, 6);
-        }
-        // use sboxes
-        temp = "";
+        // use sboxes on the 8 6-bit parts
+        uint32_t s = 0;
         for(uint8_t y = 0; y < 8; y++){
-            std::string s = "";
-            s += RIGHT[y][0];
-            s += RIGHT[y][5];
-            temp += makebin(DES_S_BOX[y][toint(s, 2)][toint(RIGHT[y].substr(1, 4), 2)], 4);
+            const uint8_t part = (t >> (42 - 6 * y)) & 63;
+            s = (s << 4) | DES_S_BOX[y][((part >> 4) & 2) | (part & 1)][(part >> 1) & 15];
         }
 
-        // permutate
-        right = "";
-        for(uint8_t y = 0; y < 32; y++){
-            right += temp[DES_P[y]-1];
-        }
-
-        // right xor left and combine with old right
-        data = old_right + makebin(toint(left, 2) ^ toint(right, 2), 32);
+        // permutate, xor with left and swap
+        const uint32_t old_right = right;
+        right = left ^ static_cast <uint32_t> (permute(s, DES_P, 32, 32));
+        left = old_right;
     }
-    // reverse last switch
-    data = data.substr(32, 32) + data.substr(0, 32);
 
-    // IP^-1
-    uint64_t out = 0;
-    for(uint8_t x = 0; x < 64; x++){
-        out += static_cast <uint64_t> (data[DES_INVIP[x] - 1] == '1') << (63 - x);
-    }
-    return unhexlify(makehex(out, 16));
+    // reverse last switch and IP^-1
+    store_big_endian(permute((static_cast <uint64_t> (right) << 32) | left, DES_INVIP, 64, 64), out);
 }
 
 DES::DES()
@@ -112,16 +80,53 @@ void DES::setkey(const std::string & KEY){
 }
 
 std::string DES::encrypt(const std::string & DATA){
-    return run(DATA);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits in length.");
+    }
+
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), true);
+    return out;
 }
 
 std::string DES::decrypt(const std::string & DATA){
-    std::reverse(keys, keys + 16);
-    std::string out = run(DATA);
-    std::reverse(keys, keys + 16);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits in length.");
+    }
+
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), false);
     return out;
 }
 
+void DES::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), true);
+    }
+}
+
+void DES::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), false);
+    }
+}
+
 unsigned int DES::blocksize() const {
     return 64;
 }
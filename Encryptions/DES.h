@@ -35,14 +35,20 @@ THE SOFTWARE.
 class DES : public SymAlg {
     private:
         uint64_t keys[16];
-        std::string run(const std::string & data);
+        uint64_t permute(const uint64_t in, const uint8_t * table, const uint8_t in_bits, const uint8_t out_bits);
+        void run(const uint8_t * in, uint8_t * out, const bool enc);
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         DES();
         DES(const std::string & KEY);
         void setkey(const std::string & KEY);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
 };
 
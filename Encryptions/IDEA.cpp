@@ -22,29 +22,22 @@ uint16_t IDEA::mult(uint32_t value1, uint32_t value2){
 }
 // ///////////////////////
 
-std::string IDEA::run(const std::string & DATA){
-    if (!keyset){
-        throw std::runtime_error("Error: Key has not been set");
-    }
-
-    if (DATA.size() != 8){
-        throw std::runtime_error("Error: Data must be 64 bits in length.");
-    }
-
-    uint16_t x1 = toint(DATA.substr(0, 2), 256);
-    uint16_t x2 = toint(DATA.substr(2, 2), 256);
-    uint16_t x3 = toint(DATA.substr(4, 2), 256);
-    uint16_t x4 = toint(DATA.substr(6, 2), 256);
+void IDEA::run(const uint8_t * in, uint8_t * out, const uint16_t * keys){
+    uint16_t x1 = load_big_endian <uint16_t> (in);
+    uint16_t x2 = load_big_endian <uint16_t> (in + 2);
+    uint16_t x3 = load_big_endian <uint16_t> (in + 4);
+    uint16_t x4 = load_big_endian <uint16_t> (in + 6);
     for(uint8_t x = 0; x < 8; x++){
-        uint16_t t1 = mult(x1, keys[x][0]);
-        uint16_t t2 = static_cast <uint16_t> (x2 + keys[x][1]);
-        uint16_t t3 = static_cast <uint16_t> (x3 + keys[x][2]);
-        uint16_t t4 = mult(x4, keys[x][3]);
+        const uint16_t * key = keys + 6 * x;
+        uint16_t t1 = mult(x1, key[0]);
+        uint16_t t2 = static_cast <uint16_t> (x2 + key[1]);
+        uint16_t t3 = static_cast <uint16_t> (x3 + key[2]);
+        uint16_t t4 = mult(x4, key[3]);
         uint16_t t5 = t1 ^ t3;
         uint16_t t6 = t2 ^ t4;
-        uint16_t t7 = mult(t5, keys[x][4]);
+        uint16_t t7 = mult(t5, key[4]);
         uint16_t t8 = static_cast <uint16_t> (t6 + t7);
-        uint16_t t9 = mult(t8, keys[x][5]);
+        uint16_t t9 = mult(t8, key[5]);
         uint16_t t10 = static_cast <uint16_t> (t7 + t9);
         x1 = t1 ^ t9;
         x2 = t3 ^ t9;
@@ -52,17 +45,16 @@ std::string IDEA::run(const std::string & DATA){
         x4 = t4 ^ t10;
     }
     std::swap(x2, x3);
-    x1 = mult(x1, keys[8][0]);
-    x2 = static_cast <uint16_t> (x2 + keys[8][1]);
-    x3 = static_cast <uint16_t> (x3 + keys[8][2]);
-    x4 = mult(x4, keys[8][3]);
-    return unhexlify(makehex(x1, 4) + makehex(x2, 4) + makehex(x3, 4) + makehex(x4, 4));
+    store_big_endian(mult(x1, keys[48]), out);
+    store_big_endian(static_cast <uint16_t> (x2 + keys[49]), out + 2);
+    store_big_endian(static_cast <uint16_t> (x3 + keys[50]), out + 4);
+    store_big_endian(mult(x4, keys[51]), out + 6);
 }
 
 IDEA::IDEA()
     : SymAlg(),
-      keys(),
-      k()
+      ekeys(),
+      dkeys()
 {}
 
 IDEA::IDEA(const std::string & KEY)
@@ -104,8 +96,24 @@ void IDEA::setkey(const std::string & KEY){
     temp.erase(temp.begin() + 52, temp.end());
 
     for(uint8_t x = 0; x < temp.size(); x++){
-        k.push_back(toint(temp[x], 16));
+        ekeys[x] = toint(temp[x], 16);
     }
+
+    // decryption subkeys
+    for(uint8_t x = 0; x < 8; x++){
+        dkeys[6 * x]     = invmod(static_cast <int> (65537), static_cast <int> (ekeys[48 - 6 * x]));
+        dkeys[6 * x + 1] = two_comp(ekeys[50 - 6 * x]);
+        dkeys[6 * x + 2] = two_comp(ekeys[49 - 6 * x]);
+        dkeys[6 * x + 3] = invmod(static_cast <int> (65537), static_cast <int> (ekeys[51 - 6 * x]));
+        dkeys[6 * x + 4] = ekeys[46 - 6 * x];
+        dkeys[6 * x + 5] = ekeys[47 - 6 * x];
+    }
+    dkeys[48] = invmod(static_cast <int> (65537), static_cast <int> (ekeys[0]));
+    dkeys[49] = two_comp(ekeys[1]);
+    dkeys[50] = two_comp(ekeys[2]);
+    dkeys[51] = invmod(static_cast <int> (65537), static_cast <int> (ekeys[3]));
+    std::swap(dkeys[1], dkeys[2]);
+
     keyset = true;
 }
 
@@ -118,23 +126,9 @@ std::string IDEA::encrypt(const std::string & DATA){
         throw std::runtime_error("Error: Data must be 64 bits in length.");
     }
 
-    keys.clear();
-    std::vector <uint16_t> t;
-    for(uint8_t x = 0; x < 8; x++){
-        for(uint8_t y = 0; y < 6; y++){
-            t.push_back(k[6 * x + y]);
-        }
-        keys.push_back(t);
-        t.clear();
-    }
-
-    for(uint8_t x = 48; x < 52; x++){
-        t.push_back(k[x]);
-    }
-
-    keys.push_back(t);
-    t.clear();
-    return run(DATA);
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), ekeys);
+    return out;
 }
 
 std::string IDEA::decrypt(const std::string & DATA){
@@ -146,37 +140,29 @@ std::string IDEA::decrypt(const std::string & DATA){
         throw std::runtime_error("Error: Data must be 64 bits in length.");
     }
 
-    keys.clear();
-    std::vector <uint16_t> t;
-    for(uint8_t x = 0; x < 8; x++){
-        k.push_back(invmod(static_cast <int> (65537), static_cast <int> (k[48 - 6 * x])));
-        k.push_back(two_comp(k[50 - 6 * x]));
-        k.push_back(two_comp(k[49 - 6 * x]));
-        k.push_back(invmod(static_cast <int> (65537), static_cast <int> (k[51 - 6 * x])));
-        k.push_back(k[46 - 6 * x]);
-        k.push_back(k[47 - 6 * x]);
-    }
-    k.push_back(invmod(static_cast <int> (65537), static_cast <int> (k[0])));
-    k.push_back(two_comp(k[1]));
-    k.push_back(two_comp(k[2]));
-    k.push_back(invmod(static_cast <int> (65537), static_cast <int> (k[3])));
-    k.erase(k.begin(), k.begin() + 52);
+    std::string out(8, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), dkeys);
+    return out;
+}
 
-    for(uint8_t x = 0; x < 8; x++){
-        for(uint8_t y = 0; y < 6; y++){
-            t.push_back(k[6 * x + y]);
-        }
-        keys.push_back(t);
-        t.clear();
+void IDEA::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), ekeys);
+    }
+}
+
+void IDEA::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
     }
 
-    for(uint8_t x = 48; x < 52; x++){
-        t.push_back(k[x]);
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 3), out + (x << 3), dkeys);
     }
-    keys.push_back(t);
-    t.clear();
-    std::swap(keys[0][1], keys[0][2]);
-    return run(DATA);
 }
 
 unsigned int IDEA::blocksize() const {
@@ -33,17 +33,21 @@ THE SOFTWARE.
 
 class IDEA : public SymAlg {
     private:
-        std::vector <std::vector <uint16_t> > keys;
-        std::vector <uint16_t> k;
+        uint16_t ekeys[52], dkeys[52];
         uint16_t mult(uint32_t value1, uint32_t value2);
-        std::string run(const std::string & data);
+        void run(const uint8_t * in, uint8_t * out, const uint16_t * keys);
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         IDEA();
         IDEA(const std::string & KEY);
         void setkey(const std::string & KEY);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
 };
 
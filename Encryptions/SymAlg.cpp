@@ -1,7 +1,33 @@
 #include "SymAlg.h"
 
+#include <algorithm>
+
 SymAlg::SymAlg() 
     : keyset(false)
 {}
 
 SymAlg::~SymAlg(){}
+
+void SymAlg::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    const std::size_t BS = blocksize() >> 3;
+    for(std::size_t x = 0; x < blocks; x++){
+        const std::string block = encrypt(std::string(reinterpret_cast <const char *> (in + x * BS), BS));
+        std::copy(block.begin(), block.end(), out + x * BS);
+    }
+}
+
+void SymAlg::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    const std::size_t BS = blocksize() >> 3;
+    for(std::size_t x = 0; x < blocks; x++){
+        const std::string block = decrypt(std::string(reinterpret_cast <const char *> (in + x * BS), BS));
+        std::copy(block.begin(), block.end(), out + x * BS);
+    }
+}
+
+void SymAlg::encrypt_blocks(uint8_t * data, const std::size_t blocks){
+    encrypt_blocks(data, data, blocks);
+}
+
+void SymAlg::decrypt_blocks(uint8_t * data, const std::size_t blocks){
+    decrypt_blocks(data, data, blocks);
+}
@@ -25,9 +25,11 @@ THE SOFTWARE.
 #ifndef __SYMALG__
 #define __SYMALG__
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 class SymAlg{
     protected:
@@ -40,6 +42,18 @@ class SymAlg{
         virtual ~SymAlg();
         virtual std::string encrypt(const std::string & DATA) = 0;
         virtual std::string decrypt(const std::string & DATA) = 0;
+
+        // process blocks contiguous blocks of blocksize() / 8 octets each
+        // in and out may point to the same buffer
+        // the default implementations go through encrypt/decrypt one block at a time
+        // once the key is set, these do not modify the object and may be called from several threads
+        virtual void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        virtual void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+
+        // in place versions of the above
+        void encrypt_blocks(uint8_t * data, const std::size_t blocks);
+        void decrypt_blocks(uint8_t * data, const std::size_t blocks);
+
         virtual unsigned int blocksize() const = 0; // blocksize in bits
 };
 
@@ -1,18 +1,12 @@
 #include "TDES.h"
 
-std::string TDES::run(const std::string & data, const std::string & key, const bool & mode){
-    if (!keyset){
-        throw std::runtime_error("Error: Key has not been set.");
-    }
-
-    if (data.size() != 8){
-        throw std::runtime_error("Error: Data must be 64 bits in length.");
-    }
-
+void TDES::run(DES & des, const bool mode, const uint8_t * in, uint8_t * out, const std::size_t blocks){
     if (!mode){
-        return DES(key).encrypt(data);
+        des.encrypt_blocks(in, out, blocks);
+    }
+    else{
+        des.decrypt_blocks(in, out, blocks);
     }
-    return DES(key).decrypt(data);
 }
 
 TDES::TDES()
@@ -44,9 +38,9 @@ void TDES::setkey(const std::string & key1, const std::string & mode1, const std
         throw std::runtime_error("Error: Key must be 64 bits in length.");
     }
 
-    k1 = key1;
-    k2 = key2;
-    k3 = key3;
+    k1.setkey(key1);
+    k2.setkey(key2);
+    k3.setkey(key3);
     m1 = (mode1 == "d");
     m2 = (mode2 == "d");
     m3 = (mode3 == "d");
@@ -55,11 +49,45 @@ void TDES::setkey(const std::string & key1, const std::string & mode1, const std
 }
 
 std::string TDES::encrypt(const std::string & DATA){
-    return run(run(run(DATA, k1, m1), k2, m2), k3, m3);
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits in length.");
+    }
+
+    std::string out(8, 0);
+    encrypt_blocks(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), 1);
+    return out;
 }
 
 std::string TDES::decrypt(const std::string & DATA){
-    return run(run(run(DATA, k1, !m1), k2, !m2), k3, !m3);
+    if (DATA.size() != 8){
+        throw std::runtime_error("Error: Data must be 64 bits in length.");
+    }
+
+    std::string out(8, 0);
+    decrypt_blocks(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), 1);
+    return out;
+}
+
+void TDES::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    // each stage runs over all of the blocks before the next one starts
+    run(k1, m1, in, out, blocks);
+    run(k2, m2, out, out, blocks);
+    run(k3, m3, out, out, blocks);
+}
+
+void TDES::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    // undo the stages in reverse order
+    run(k3, !m3, in, out, blocks);
+    run(k2, !m2, out, out, blocks);
+    run(k1, !m1, out, out, blocks);
 }
 
 unsigned int TDES::blocksize() const {
@@ -29,16 +29,21 @@ THE SOFTWARE.
 #define __TDES__
 class TDES : public SymAlg {
     private:
-        std::string k1, k2, k3;
+        DES k1, k2, k3;
         bool m1, m2, m3;
-        std::string run(const std::string & data, const std::string & key, const bool & mode);
+        void run(DES & des, const bool mode, const uint8_t * in, uint8_t * out, const std::size_t blocks);
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         TDES();
         TDES(const std::string & key1, const std::string & mode1, const std::string & key2, const std::string & mode2, const std::string & key3, const std::string & mode3);
         void setkey(const std::string & key1, const std::string & mode1, const std::string & key2, const std::string & mode2, const std::string & key3, const std::string & mode3);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
 };
 
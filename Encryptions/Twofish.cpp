@@ -29,20 +29,13 @@ uint32_t Twofish::h_fun(uint32_t x, const std::vector<uint32_t> & key){
     return m_tab[0][b0] ^ m_tab[1][b1] ^ m_tab[2][b2] ^ m_tab[3][b3];
 }
 
-std::string Twofish::run(const std::string & data, bool enc){
-    if (!keyset){
-        throw std::runtime_error("Error: Key has not been set");
-    }
-
-    if (data.size() != 16){
-        throw std::runtime_error("Error: Data must be 128 bits in length.");
-    }
+void Twofish::run(const uint8_t * in, uint8_t * out, const bool enc){
     uint32_t t0, t1;
-    std::vector<uint32_t> blk(4, 0);
-    blk[0] = toint(little_end(data.substr(0, 4), 256), 256);
-    blk[1] = toint(little_end(data.substr(4, 4), 256), 256);
-    blk[2] = toint(little_end(data.substr(8, 4), 256), 256);
-    blk[3] = toint(little_end(data.substr(12, 4), 256), 256);
+    uint32_t blk[4];
+    blk[0] = load_little_endian <uint32_t> (in);
+    blk[1] = load_little_endian <uint32_t> (in + 4);
+    blk[2] = load_little_endian <uint32_t> (in + 8);
+    blk[3] = load_little_endian <uint32_t> (in + 12);
 
     blk[0] ^= l_key[enc?0:4];
     blk[1] ^= l_key[enc?1:5];
@@ -79,10 +72,10 @@ std::string Twofish::run(const std::string & data, bool enc){
     blk[0] ^= l_key[enc?6:2];
     blk[1] ^= l_key[enc?7:3];
 
-    std::swap(blk[0], blk[2]);
-    std::swap(blk[1], blk[3]);
-
-    return unhexlify(little_end(makehex(blk[0], 8)) + little_end(makehex(blk[1], 8)) + little_end(makehex(blk[2], 8)) + little_end(makehex(blk[3], 8)));
+    store_little_endian(blk[2], out);
+    store_little_endian(blk[3], out + 4);
+    store_little_endian(blk[0], out + 8);
+    store_little_endian(blk[1], out + 12);
 }
 
 Twofish::Twofish()
@@ -195,10 +188,51 @@ void Twofish::setkey(const std::string & KEY){
 }
 
 std::string Twofish::encrypt(const std::string & DATA){
-    return run(DATA, true);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 16){
+        throw std::runtime_error("Error: Data must be 128 bits in length.");
+    }
+
+    std::string out(16, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), true);
+    return out;
 }
+
 std::string Twofish::decrypt(const std::string & DATA){
-    return run(DATA, false);
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    if (DATA.size() != 16){
+        throw std::runtime_error("Error: Data must be 128 bits in length.");
+    }
+
+    std::string out(16, 0);
+    run(reinterpret_cast <const uint8_t *> (DATA.data()), reinterpret_cast <uint8_t *> (&out[0]), false);
+    return out;
+}
+
+void Twofish::encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 4), out + (x << 4), true);
+    }
+}
+
+void Twofish::decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks){
+    if (!keyset){
+        throw std::runtime_error("Error: Key has not been set.");
+    }
+
+    for(std::size_t x = 0; x < blocks; x++){
+        run(in + (x << 4), out + (x << 4), false);
+    }
 }
 
 unsigned int Twofish::blocksize() const {
@@ -14,14 +14,19 @@ class Twofish : public SymAlg {
         std::vector<std::vector<uint32_t>> mk_tab;
 
         uint32_t h_fun(uint32_t x, const std::vector<uint32_t> & key);
-        std::string run(const std::string & data, bool enc);
+        void run(const uint8_t * in, uint8_t * out, const bool enc);
 
     public:
+        using SymAlg::encrypt_blocks;
+        using SymAlg::decrypt_blocks;
+
         Twofish();
         Twofish(const std::string & KEY);
         void setkey(const std::string & KEY);
         std::string encrypt(const std::string & DATA);
         std::string decrypt(const std::string & DATA);
+        void encrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
+        void decrypt_blocks(const uint8_t * in, uint8_t * out, const std::size_t blocks);
         unsigned int blocksize() const;
 };
 
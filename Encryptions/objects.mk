@@ -1,6 +1,8 @@
 ENCRYPTIONS_OBJECTS=SymAlg.o      \
                     Encryptions.o \
                     AES.o         \
+                    AESBitsliced.o \
+                    AESNI.o       \
                     Blowfish.o    \
                     Camellia.o    \
                     CAST128.o     \
@@ -4,6 +4,16 @@ HashAlg::HashAlg(){}
 
 HashAlg::~HashAlg(){}
 
+std::string HashAlg::hexdigest(){
+    return hexlify(digest());
+}
+
 std::string HashAlg::digest(){
-    return unhexlify(hexdigest());
+    std::string out(digestsize() >> 3, 0);
+    calc_digest(reinterpret_cast <uint8_t *> (&out[0]));
+    return out;
+}
+
+void HashAlg::digest(uint8_t * out){
+    calc_digest(out);
 }
@@ -26,16 +26,22 @@ THE SOFTWARE.
 #ifndef __HASH__
 #define __HASH__
 
+#include <cstdint>
 #include <iostream>
 
 #include "../common/includes.h"
 
 class HashAlg{
+    protected:
+        // write the digest of the data so far into out without changing the state
+        virtual void calc_digest(uint8_t * out) = 0;
+
     public:
         HashAlg();
         virtual ~HashAlg();
-        virtual std::string hexdigest() = 0;
+        std::string hexdigest();
         std::string digest();
+        void digest(uint8_t * out);                 // digestsize() / 8 octets
         virtual std::size_t digestsize() const = 0; // digest size in bits
 };
 
@@ -3,36 +3,69 @@
 namespace OpenPGP {
 namespace Hash {
 
+namespace {
+
+typedef MerkleDamgard::Ptr (*Factory)();
+
+template <typename T> MerkleDamgard::Ptr make(){
+    return MerkleDamgard::Ptr(new T());
+}
+
+const std::map <uint8_t, Factory> FACTORY = {
+    std::make_pair(ID::MD5,         make <MD5>),
+    std::make_pair(ID::SHA1,        make <SHA1>),
+    std::make_pair(ID::RIPEMD160,   make <RIPEMD160>),
+    std::make_pair(ID::SHA256,      make <SHA256>),
+    std::make_pair(ID::SHA384,      make <SHA384>),
+    std::make_pair(ID::SHA512,      make <SHA512>),
+    std::make_pair(ID::SHA224,      make <SHA224>),
+};
+
+}
+
+MerkleDamgard::Ptr create(const uint8_t alg){
+    std::map <uint8_t, Factory>::const_iterator it = FACTORY.find(alg);
+    if (it == FACTORY.end()){
+        throw std::runtime_error("Error: Hash value not defined or reserved.");
+    }
+    return it -> second();
+}
+
 std::string use(const uint8_t alg, const std::string & data){
-    switch (alg){
-        // case 0: // don't hash; not defined in standard
-            // return data;
-        case ID::MD5:
-            return MD5(data).digest();
-            break;
-        case ID::SHA1:
-            return SHA1(data).digest();
-            break;
-        case ID::RIPEMD160:
-            return RIPEMD160(data).digest();
-            break;
-        case ID::SHA256:
-            return SHA256(data).digest();
-            break;
-        case ID::SHA384:
-            return SHA384(data).digest();
-            break;
-        case ID::SHA512:
-            return SHA512(data).digest();
-            break;
-        case ID::SHA224:
-            return SHA224(data).digest();
-            break;
-        default:
-            throw std::runtime_error("Error: Hash value not defined or reserved.");
-            break;
+    MerkleDamgard::Ptr hash = create(alg);
+    hash -> update(data);
+    return hash -> digest();
+}
+
+std::vector <std::string> use_batch(const uint8_t alg, const std::vector <std::string> & data){
+    if (MultiBuffer::available() && (data.size() > 1)){
+        switch (alg){
+            case ID::SHA1:
+                return MultiBuffer::sha1(data);
+                break;
+            // SHA extensions hash a single SHA-256 message about as fast as 8 AVX2 lanes
+            case ID::SHA256:
+                if (!SHANI::available()){
+                    return MultiBuffer::sha256(data);
+                }
+                break;
+            case ID::SHA224:
+                if (!SHANI::available()){
+                    return MultiBuffer::sha224(data);
+                }
+                break;
+            default:
+                break;
+        }
     }
+
+    std::vector <std::string> out;
+    out.reserve(data.size());
+    for(std::string const & d : data){
+        out.push_back(use(alg, d));
+    }
+    return out;
 }
 
 }
-}
\ No newline at end of file
+}
@@ -28,10 +28,12 @@ THE SOFTWARE.
 
 #include <map>
 #include <stdexcept>
+#include <vector>
 
 #include "HashAlg.h"
 
 #include "MD5.h"
+#include "MultiBuffer.h"
 #include "RIPEMD160.h"
 #include "SHA1.h"
 #include "SHA256.h"
@@ -127,7 +129,14 @@ namespace OpenPGP {
             std::make_pair(ID::SHA224,      224),
         };
 
+        // new hash object for incremental hashing
+        MerkleDamgard::Ptr create(const uint8_t alg);
+
         std::string use(const uint8_t alg, const std::string & data);
+
+        // hash many independent messages; same as calling use on each one, but
+        // SHA-1, SHA-224 and SHA-256 run several messages side by side when possible
+        std::vector <std::string> use_batch(const uint8_t alg, const std::vector <std::string> & data);
     }
 }
 
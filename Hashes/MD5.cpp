@@ -1,19 +1,12 @@
 #include "MD5.h"
 
-std::string MD5::to_little_end(const std::string & data) const {
-    std::string result;
-    for(unsigned int x = 0; x < (data.size() >> 2); x++){
-        result += little_end(data.substr(x << 2, 4), 256);
-    }
-    return result;
-}
-
-void MD5::calc(const std::string & data, context & state) const {
-    for(unsigned int i = 0; i < (data.size() >> 6); i++){
-        uint32_t a = state.h0, b = state.h1, c = state.h2, d = state.h3;
+void MD5::calc(const uint8_t * data, const std::size_t blocks, context & state) const {
+    for(std::size_t i = 0; i < blocks; i++){
+        const uint8_t * block = data + (i << 6);
+        uint32_t a = state.h[0], b = state.h[1], c = state.h[2], d = state.h[3];
         uint32_t w[16];
         for(uint8_t x = 0; x < 16; x++){
-            w[x] = toint(data.substr(i << 6, 64).substr(x << 2, 4), 256);
+            w[x] = load_little_endian <uint32_t> (block + (x << 2));
         }
         for(uint8_t x = 0; x < 64; x++){
             uint32_t f = 0, g = 0;
@@ -39,11 +32,25 @@ void MD5::calc(const std::string & data, context & state) const {
             b += ROL(a + f + MD5_K[x] + w[g], MD5_R[x], 32);
             a = t;
         }
-        state.h0 += a;
-        state.h1 += b;
-        state.h2 += c;
-        state.h3 += d;
+        state.h[0] += a;
+        state.h[1] += b;
+        state.h[2] += c;
+        state.h[3] += d;
+    }
+}
+
+void MD5::compress(const uint8_t * data, const std::size_t blocks){
+    calc(data, blocks, ctx);
+}
+
+void MD5::calc_digest(uint8_t * out){
+    context tmp = ctx;
+    uint8_t last[128];
+    calc(last, pad(last, 8, false), tmp);
+    for(uint8_t x = 0; x < 4; x++){
+        store_little_endian(tmp.h[x], out + (x << 2));
     }
+    wipe(last, sizeof(last));
 }
 
 MD5::MD5() :
@@ -57,32 +64,14 @@ MD5::MD5(const std::string & str) :
     update(str);
 }
 
-void MD5::update(const std::string & str){
-    std::string data = stack + str;
-    stack.clear();
-    std::string::size_type size = ((data.size() >> 6) << 6);
-    if ( std::string::size_type rem = ( data.size() - size ) ){
-        stack = data.substr(size, rem);
-    }
-    calc(to_little_end(data.substr(0, size)), ctx);
-    clen += size;
-}
-
-std::string MD5::hexdigest(){
-    context tmp = ctx;
-    uint16_t size = stack.size();
-    std::string last = stack + "\x80" + std::string((((size & 63) > 55)?119:55) - (size & 63), 0);
-    last = to_little_end(last);
-    std::string temp = unhexlify(makehex((clen+size) << 3, 16));
-    last += temp.substr(4, 4) + temp.substr(0, 4);
-    calc(last, tmp);
-    return little_end(makehex(tmp.h0, 8)) + little_end(makehex(tmp.h1, 8)) + little_end(makehex(tmp.h2, 8)) + little_end(makehex(tmp.h3, 8));
-}
-
 std::size_t MD5::blocksize() const {
     return 512;
 }
 
 std::size_t MD5::digestsize() const {
     return 128;
+}
+
+MerkleDamgard::Ptr MD5::clone() const {
+    return MerkleDamgard::Ptr(new MD5(*this));
 }
\ No newline at end of file
@@ -35,29 +35,31 @@ THE SOFTWARE.
 class MD5 : public MerkleDamgard {
     private:
         struct context{
-            uint32_t h0, h1, h2, h3;
+            uint32_t h[4];
+
             context(uint32_t h0, uint32_t h1, uint32_t h2, uint32_t h3) :
-                h0(h0),
-                h1(h1),
-                h2(h2),
-                h3(h3)
+                h{h0, h1, h2, h3}
             {}
             ~context(){
-                h0 = h1 = h2 = h3 = 0;
+                for(uint32_t & x : h){
+                    x = 0;
+                }
             }
         };
         context ctx;
 
-        std::string to_little_end(const std::string & data) const;
-        void calc(const std::string & data, context & state) const;
+        // process complete 64 octet blocks
+        void calc(const uint8_t * data, const std::size_t blocks, context & state) const;
+
+        void compress(const uint8_t * data, const std::size_t blocks);
+        void calc_digest(uint8_t * out);
 
     public:
         MD5();
         MD5(const std::string & data);
-        void update(const std::string & data);
-        std::string hexdigest();
         std::size_t blocksize() const;
         std::size_t digestsize() const;
+        MerkleDamgard::Ptr clone() const;
 };
 
 #endif
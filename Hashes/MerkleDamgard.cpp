@@ -1,9 +1,82 @@
 #include "MerkleDamgard.h"
 
+#include <algorithm>
+
 MerkleDamgard::MerkleDamgard()
     : HashAlg(),
       stack(),
+      stacked(0),
       clen(0)
 {}
 
-MerkleDamgard::~MerkleDamgard(){}
\ No newline at end of file
+MerkleDamgard::~MerkleDamgard(){
+    wipe(stack, sizeof(stack));
+}
+
+void MerkleDamgard::wipe(uint8_t * buf, const std::size_t len){
+    volatile uint8_t * v = buf;
+    for(std::size_t i = 0; i < len; i++){
+        v[i] = 0;
+    }
+}
+
+std::size_t MerkleDamgard::pad(uint8_t * last, const std::size_t len_size, const bool big_endian) const {
+    const std::size_t bs = blocksize() >> 3;
+    const std::size_t blocks = ((stacked + 1 + len_size) > bs)?2:1;
+    const std::size_t size = blocks * bs;
+
+    std::copy(stack, stack + stacked, last);
+    last[stacked] = 0x80;
+    std::fill(last + stacked + 1, last + size, 0);
+
+    // only the low 64 bits of the length are ever non-zero
+    const uint64_t bits = (clen + stacked) << 3;
+    if (big_endian){
+        store_big_endian(bits, last + size - 8);
+        if (len_size > 8){
+            last[size - 9] = static_cast <uint8_t> ((clen + stacked) >> 61);
+        }
+    }
+    else{
+        store_little_endian(bits, last + size - len_size);
+    }
+
+    return blocks;
+}
+
+void MerkleDamgard::update(const std::string & str){
+    update(reinterpret_cast <const uint8_t *> (str.data()), str.size());
+}
+
+void MerkleDamgard::update(const uint8_t * data, std::size_t len){
+    const std::size_t bs = blocksize() >> 3;
+
+    // finish a previously started block
+    if (stacked){
+        const std::size_t take = std::min(len, bs - stacked);
+        std::copy(data, data + take, stack + stacked);
+        stacked += take;
+        data += take;
+        len -= take;
+
+        if (stacked < bs){
+            return;
+        }
+
+        compress(stack, 1);
+        clen += bs;
+        stacked = 0;
+    }
+
+    // whole blocks straight from the input
+    const std::size_t blocks = len / bs;
+    if (blocks){
+        compress(data, blocks);
+        clen += blocks * bs;
+        data += blocks * bs;
+        len -= blocks * bs;
+    }
+
+    std::copy(data, data + len, stack);
+    stacked = len;
+}
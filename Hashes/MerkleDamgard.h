@@ -26,18 +26,38 @@ THE SOFTWARE.
 #ifndef __MERKLE_DAMGARD__
 #define __MERKLE_DAMGARD__
 
+#include <memory>
+
 #include "HashAlg.h"
 
 class MerkleDamgard : public HashAlg {
     protected:
-        std::string stack;
-        uint64_t clen;
+        uint8_t stack[128];     // partial block waiting for more data
+        std::size_t stacked;    // octets in stack
+        uint64_t clen;          // octets already compressed
+
+        // process complete blocks of blocksize() / 8 octets into the running state
+        virtual void compress(const uint8_t * data, const std::size_t blocks) = 0;
+
+        // fill last with the stack, the 0x80 terminator, zeros and the message
+        // length in bits as a len_size octet integer, returning the number of blocks
+        // last must hold 2 blocks
+        std::size_t pad(uint8_t * last, const std::size_t len_size, const bool big_endian) const;
+
+        // zero a buffer that held message octets; the stores are not optimized away
+        static void wipe(uint8_t * buf, const std::size_t len);
 
     public:
+        typedef std::unique_ptr <MerkleDamgard> Ptr;
+
         MerkleDamgard();
         virtual ~MerkleDamgard();
-        virtual void update(const std::string & str) = 0;
+        void update(const std::string & str);
+        void update(const uint8_t * data, std::size_t len);
         virtual std::size_t blocksize() const = 0;  // blocksize in bits
+
+        // independent copy of the current state, so a common prefix only has to be hashed once
+        virtual Ptr clone() const = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,327 @@
+#include "MultiBuffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "SHA256_Const.h"
+#include "SHA2_AVX2.h"
+#include "../common/CPU.h"
+
+#ifdef CPU_X86
+#define MULTIBUFFER_SUPPORTED
+#endif
+
+#ifdef MULTIBUFFER_SUPPORTED
+
+#include <immintrin.h>
+
+#define MULTIBUFFER_TARGET __attribute__((target("avx2")))
+
+namespace MultiBuffer {
+
+namespace {
+
+uint32_t load(const uint8_t * in){
+    return (static_cast <uint32_t> (in[0]) << 24) | (static_cast <uint32_t> (in[1]) << 16) | (static_cast <uint32_t> (in[2]) << 8) | in[3];
+}
+
+// word j of every lane's block
+MULTIBUFFER_TARGET
+__m256i gather(const uint8_t * const block[LANES], const uint8_t j){
+    const uint8_t o = j << 2;
+    return _mm256_set_epi32(load(block[7] + o), load(block[6] + o), load(block[5] + o), load(block[4] + o),
+                            load(block[3] + o), load(block[2] + o), load(block[1] + o), load(block[0] + o));
+}
+
+// value i of every lane's state
+MULTIBUFFER_TARGET
+__m256i get(uint32_t * const state[LANES], const uint8_t i){
+    return _mm256_set_epi32(state[7][i], state[6][i], state[5][i], state[4][i],
+                            state[3][i], state[2][i], state[1][i], state[0][i]);
+}
+
+MULTIBUFFER_TARGET
+void put(uint32_t * const state[LANES], const uint8_t i, const __m256i x){
+    uint32_t out[LANES];
+    _mm256_storeu_si256(reinterpret_cast <__m256i *> (out), x);
+    for(std::size_t l = 0; l < LANES; l++){
+        state[l][i] = out[l];
+    }
+}
+
+MULTIBUFFER_TARGET
+__m256i add(const __m256i a, const __m256i b){
+    return _mm256_add_epi32(a, b);
+}
+
+MULTIBUFFER_TARGET
+__m256i rol(const __m256i x, const int n){
+    return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+}
+
+MULTIBUFFER_TARGET
+__m256i ror(const __m256i x, const int n){
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+MULTIBUFFER_TARGET
+__m256i ch(const __m256i x, const __m256i y, const __m256i z){
+    return _mm256_xor_si256(z, _mm256_and_si256(x, _mm256_xor_si256(y, z)));
+}
+
+MULTIBUFFER_TARGET
+__m256i maj(const __m256i x, const __m256i y, const __m256i z){
+    return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y)));
+}
+
+MULTIBUFFER_TARGET
+__m256i parity(const __m256i x, const __m256i y, const __m256i z){
+    return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+}
+
+}
+
+bool available(){
+    return SHA2_AVX2::available();
+}
+
+MULTIBUFFER_TARGET
+void sha1_blocks(uint32_t * const state[LANES], const uint8_t * const block[LANES]){
+    __m256i w[16];
+    for(uint8_t j = 0; j < 16; j++){
+        w[j] = gather(block, j);
+    }
+
+    __m256i a = get(state, 0), b = get(state, 1), c = get(state, 2), d = get(state, 3), e = get(state, 4);
+    const __m256i a0 = a, b0 = b, c0 = c, d0 = d, e0 = e;
+
+    for(uint8_t t = 0; t < 80; t++){
+        if (t >= 16){
+            w[t & 15] = rol(_mm256_xor_si256(_mm256_xor_si256(w[(t - 3) & 15], w[(t - 8) & 15]),
+                                             _mm256_xor_si256(w[(t - 14) & 15], w[t & 15])), 1);
+        }
+
+        __m256i f, k;
+        if (t < 20){
+            f = ch(b, c, d);
+            k = _mm256_set1_epi32(0x5A827999);
+        }
+        else if (t < 40){
+            f = parity(b, c, d);
+            k = _mm256_set1_epi32(0x6ED9EBA1);
+        }
+        else if (t < 60){
+            f = maj(b, c, d);
+            k = _mm256_set1_epi32(0x8F1BBCDC);
+        }
+        else{
+            f = parity(b, c, d);
+            k = _mm256_set1_epi32(0xCA62C1D6);
+        }
+
+        const __m256i temp = add(add(rol(a, 5), f), add(add(e, k), w[t & 15]));
+        e = d;
+        d = c;
+        c = rol(b, 30);
+        b = a;
+        a = temp;
+    }
+
+    put(state, 0, add(a, a0));
+    put(state, 1, add(b, b0));
+    put(state, 2, add(c, c0));
+    put(state, 3, add(d, d0));
+    put(state, 4, add(e, e0));
+}
+
+MULTIBUFFER_TARGET
+void sha256_blocks(uint32_t * const state[LANES], const uint8_t * const block[LANES]){
+    __m256i w[16];
+    for(uint8_t j = 0; j < 16; j++){
+        w[j] = gather(block, j);
+    }
+
+    __m256i h0[8];
+    for(uint8_t i = 0; i < 8; i++){
+        h0[i] = get(state, i);
+    }
+    __m256i a = h0[0], b = h0[1], c = h0[2], d = h0[3], e = h0[4], f = h0[5], g = h0[6], h = h0[7];
+
+    for(uint8_t t = 0; t < 64; t++){
+        if (t >= 16){
+            const __m256i w15 = w[(t - 15) & 15];
+            const __m256i w2  = w[(t - 2) & 15];
+            const __m256i s0  = _mm256_xor_si256(_mm256_xor_si256(ror(w15, 7), ror(w15, 18)), _mm256_srli_epi32(w15, 3));
+            const __m256i s1  = _mm256_xor_si256(_mm256_xor_si256(ror(w2, 17), ror(w2, 19)), _mm256_srli_epi32(w2, 10));
+            w[t & 15] = add(add(w[t & 15], s0), add(w[(t - 7) & 15], s1));
+        }
+
+        const __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(ror(e, 6), ror(e, 11)), ror(e, 25));
+        const __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(ror(a, 2), ror(a, 13)), ror(a, 22));
+        const __m256i t1 = add(add(h, S1), add(add(ch(e, f, g), _mm256_set1_epi32(SHA256_K[t])), w[t & 15]));
+        const __m256i t2 = add(S0, maj(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, t2);
+    }
+
+    put(state, 0, add(a, h0[0]));
+    put(state, 1, add(b, h0[1]));
+    put(state, 2, add(c, h0[2]));
+    put(state, 3, add(d, h0[3]));
+    put(state, 4, add(e, h0[4]));
+    put(state, 5, add(f, h0[5]));
+    put(state, 6, add(g, h0[6]));
+    put(state, 7, add(h, h0[7]));
+}
+
+}
+
+#else
+
+namespace MultiBuffer {
+
+bool available(){
+    return false;
+}
+
+void sha1_blocks(uint32_t * const *, const uint8_t * const *){
+    throw std::runtime_error("Error: AVX2 is not supported on this platform.");
+}
+
+void sha256_blocks(uint32_t * const *, const uint8_t * const *){
+    throw std::runtime_error("Error: AVX2 is not supported on this platform.");
+}
+
+}
+
+#endif
+
+namespace MultiBuffer {
+
+namespace {
+
+typedef void (*Compress)(uint32_t * const state[LANES], const uint8_t * const block[LANES]);
+
+const uint32_t SHA1_H[5]   = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+const uint32_t SHA224_H[8] = {0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4};
+const uint32_t SHA256_H[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+struct Lane{
+    const uint8_t * data;   // complete blocks are read from the message itself
+    std::size_t index;      // message being hashed
+    std::size_t block;      // next block
+    std::size_t full;       // number of complete blocks in the message
+    std::size_t blocks;     // total number of blocks, including padding
+    uint32_t h[8];
+    uint8_t tail[128];      // last partial block + padding
+
+    ~Lane(){
+        std::fill(h, h + 8, 0);
+        std::fill(tail, tail + 128, 0);
+    }
+
+    void start(const std::string & message, const std::size_t i, const uint32_t * iv, const uint8_t words){
+        data = reinterpret_cast <const uint8_t *> (message.data());
+        index = i;
+        block = 0;
+        full = message.size() >> 6;
+
+        const std::size_t rem = message.size() & 63;
+        blocks = full + (((rem + 9) > 64)?2:1);
+
+        const std::size_t size = (blocks - full) << 6;
+        std::copy(data + (full << 6), data + message.size(), tail);
+        tail[rem] = 0x80;
+        std::fill(tail + rem + 1, tail + size - 8, 0);
+        const uint64_t bits = static_cast <uint64_t> (message.size()) << 3;
+        for(uint8_t x = 0; x < 8; x++){
+            tail[size - 1 - x] = static_cast <uint8_t> (bits >> (x << 3));
+        }
+
+        std::copy(iv, iv + words, h);
+    }
+
+    const uint8_t * next() const {
+        return (block < full)?(data + (block << 6)):(tail + ((block - full) << 6));
+    }
+};
+
+std::vector <std::string> run(const std::vector <std::string> & data, const uint32_t * iv, const uint8_t words, const uint8_t digest_words, Compress compress){
+    static const uint8_t ZEROS[64] = {};
+
+    if (!available()){
+        throw std::runtime_error("Error: AVX2 is not supported by this CPU.");
+    }
+
+    std::vector <std::string> out(data.size());
+    Lane lane[LANES];
+    bool active[LANES] = {};
+    uint32_t scratch[8] = {};
+    std::size_t next = 0;
+
+    while (true){
+        uint32_t * state[LANES];
+        const uint8_t * block[LANES];
+        bool any = false;
+        for(std::size_t l = 0; l < LANES; l++){
+            if (!active[l] && (next < data.size())){
+                lane[l].start(data[next], next, iv, words);
+                active[l] = true;
+                next++;
+            }
+
+            if (active[l]){
+                state[l] = lane[l].h;
+                block[l] = lane[l].next();
+                any = true;
+            }
+            else{
+                state[l] = scratch;
+                block[l] = ZEROS;
+            }
+        }
+
+        if (!any){
+            break;
+        }
+
+        compress(state, block);
+
+        for(std::size_t l = 0; l < LANES; l++){
+            if (active[l] && (++lane[l].block == lane[l].blocks)){
+                std::string & digest = out[lane[l].index];
+                digest.resize(digest_words << 2);
+                for(uint8_t x = 0; x < digest_words; x++){
+                    for(uint8_t y = 0; y < 4; y++){
+                        digest[(x << 2) + y] = static_cast <char> (lane[l].h[x] >> (24 - (y << 3)));
+                    }
+                }
+                active[l] = false;
+            }
+        }
+    }
+
+    return out;
+}
+
+}
+
+std::vector <std::string> sha1(const std::vector <std::string> & data){
+    return run(data, SHA1_H, 5, 5, sha1_blocks);
+}
+
+std::vector <std::string> sha224(const std::vector <std::string> & data){
+    return run(data, SHA224_H, 8, 7, sha256_blocks);
+}
+
+std::vector <std::string> sha256(const std::vector <std::string> & data){
+    return run(data, SHA256_H, 8, 8, sha256_blocks);
+}
+
+}
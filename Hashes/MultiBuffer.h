@@ -0,0 +1,62 @@
+/*
+MultiBuffer.h
+SHA-1 and SHA-256 over 8 independent messages at once using AVX2
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __MULTIBUFFER__
+#define __MULTIBUFFER__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Each 32 bit AVX2 element holds the same word of a different message, so
+// 8 unrelated messages are compressed with one instruction stream. This only
+// pays off when there are many messages; a single long message should use
+// SHA1 / SHA256 directly.
+//
+// state[i] holds the chaining values of lane i (h0 first) and block[i]
+// points to the next 64 octet block of lane i. All lanes are processed,
+// so unused lanes need a scratch state and block.
+//
+// The *_blocks functions only work if available() returns true; the
+// message functions check it and throw otherwise.
+namespace MultiBuffer {
+    const std::size_t LANES = 8;
+
+    // whether or not the current CPU and OS support AVX2
+    bool available();
+
+    void sha1_blocks(uint32_t * const state[LANES], const uint8_t * const block[LANES]);
+    void sha256_blocks(uint32_t * const state[LANES], const uint8_t * const block[LANES]);
+
+    // binary digests of every message, in order
+    // messages of different lengths are fine; a lane picks up the next
+    // message as soon as its current one is done
+    std::vector <std::string> sha1(const std::vector <std::string> & data);
+    std::vector <std::string> sha224(const std::vector <std::string> & data);
+    std::vector <std::string> sha256(const std::vector <std::string> & data);
+}
+
+#endif
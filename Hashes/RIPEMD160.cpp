@@ -18,20 +18,13 @@ uint32_t RIPEMD160::F(const uint32_t & x, const uint32_t & y, const uint32_t & z
     }
 }
 
-std::string RIPEMD160::to_little_end(const std::string &data) const {
-    std::string result;
-    for(unsigned int x = 0; x < (data.size() >> 2); x++){
-        result += little_end(data.substr(x << 2, 4), 256);
-    }
-    return result;
-}
-
-void RIPEMD160::calc(const std::string &data, context &state) const {
-    for(unsigned int i = 0; i < (data.size() >> 6); i++){
-        uint32_t a = state.h0, b = state.h1, c = state.h2, d = state.h3, e = state.h4, A = state.h0, B = state.h1, C = state.h2, D = state.h3, E = state.h4;
+void RIPEMD160::calc(const uint8_t * data, const std::size_t blocks, context & state) const {
+    for(std::size_t i = 0; i < blocks; i++){
+        const uint8_t * block = data + (i << 6);
+        uint32_t a = state.h[0], b = state.h[1], c = state.h[2], d = state.h[3], e = state.h[4], A = state.h[0], B = state.h[1], C = state.h[2], D = state.h[3], E = state.h[4];
         uint32_t X[16];
         for(uint8_t j = 0; j < 16; j++){
-            X[j] = toint(data.substr(i << 6, 64).substr(j << 2, 4), 256);
+            X[j] = load_little_endian <uint32_t> (block + (j << 2));
         }
         uint32_t T;
         for(uint8_t j = 0; j < 80; j++){
@@ -41,13 +34,27 @@ void RIPEMD160::calc(const std::string &data, context &state) const {
             A = E; E = D; D = ROL(C, 10, 32); C = B; B = T;
 
         }
-        T        = state.h1 + c + D;
-        state.h1 = state.h2 + d + E;
-        state.h2 = state.h3 + e + A;
-        state.h3 = state.h4 + a + B;
-        state.h4 = state.h0 + b + C;
-        state.h0 = T;
+        T          = state.h[1] + c + D;
+        state.h[1] = state.h[2] + d + E;
+        state.h[2] = state.h[3] + e + A;
+        state.h[3] = state.h[4] + a + B;
+        state.h[4] = state.h[0] + b + C;
+        state.h[0] = T;
+    }
+}
+
+void RIPEMD160::compress(const uint8_t * data, const std::size_t blocks){
+    calc(data, blocks, ctx);
+}
+
+void RIPEMD160::calc_digest(uint8_t * out){
+    context tmp = ctx;
+    uint8_t last[128];
+    calc(last, pad(last, 8, false), tmp);
+    for(uint8_t x = 0; x < 5; x++){
+        store_little_endian(tmp.h[x], out + (x << 2));
     }
+    wipe(last, sizeof(last));
 }
 
 RIPEMD160::RIPEMD160() :
@@ -61,32 +68,14 @@ RIPEMD160::RIPEMD160(const std::string & str) :
     update(str);
 }
 
-void RIPEMD160::update(const std::string & str){
-    std::string data = stack + str;
-    stack.clear();
-    std::string::size_type size = ((data.size() >> 6) << 6);
-    if ( std::string::size_type rem = ( data.size() - size ) ){
-        stack = data.substr(size, rem);
-    }
-    calc(to_little_end(data.substr(0, size)), ctx);
-    clen += size;
-}
-
-std::string RIPEMD160::hexdigest(){
-    context tmp = ctx;
-    uint16_t size = stack.size();
-    std::string last = stack + "\x80" + std::string((((size & 63) > 55)?119:55) - (size & 63), 0);
-    last = to_little_end(last);
-    std::string temp = unhexlify(makehex(((clen+size) << 3), 16));
-    last += temp.substr(4, 4) + temp.substr(0, 4);
-    calc(last, tmp);
-    return little_end(makehex(tmp.h0, 8)) + little_end(makehex(tmp.h1, 8)) + little_end(makehex(tmp.h2, 8)) + little_end(makehex(tmp.h3, 8)) + little_end(makehex(tmp.h4, 8));
-}
-
 std::size_t RIPEMD160::blocksize() const {
     return 512;
 }
 
 std::size_t RIPEMD160::digestsize() const {
     return 160;
+}
+
+MerkleDamgard::Ptr RIPEMD160::clone() const {
+    return MerkleDamgard::Ptr(new RIPEMD160(*this));
 }
\ No newline at end of file
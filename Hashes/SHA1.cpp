@@ -1,77 +1,117 @@
 #include "SHA1.h"
 
-void SHA1::calc(const std::string & data, context & state) const {
-    for(unsigned int n = 0; n < (data.size() >> 6); n++){
-        std::string temp = data.substr(n << 6, 64);
-        uint32_t skey[80];
+namespace {
+
+uint32_t rol(const uint32_t x, const uint8_t n){
+    return (x << n) | (x >> (32 - n));
+}
+
+}
+
+// one round with the given f(b, c, d) + k, rotating the variables by renaming
+#define SHA1_ROUND(a, b, c, d, e, f, k, w) \
+    e += rol(a, 5) + (f) + k + w;          \
+    b = rol(b, 30);
+
+void SHA1::calc(const uint8_t * data, const std::size_t blocks, context & state) const {
+    if (impl == SHANI){
+        SHANI::sha1_blocks(state.h, data, blocks);
+        return;
+    }
+
+    for(std::size_t n = 0; n < blocks; n++){
+        const uint8_t * block = data + (n << 6);
+
+        // only the last 16 words of the schedule are needed at any time
+        uint32_t w[16];
         for(uint8_t x = 0; x < 16; x++){
-            skey[x] = toint(temp.substr(x << 2, 4), 256);
+            w[x] = load_big_endian <uint32_t> (block + (x << 2));
         }
-        for(uint8_t x = 16; x < 80; x++){
-            skey[x] = ROL((skey[x - 3] ^ skey[x - 8] ^ skey[x - 14] ^ skey[x - 16]), 1, 32);
-        }
-        uint32_t a = state.h0, b = state.h1, c = state.h2, d = state.h3, e = state.h4;
-        for(uint8_t j = 0; j < 80; j++){
-            uint32_t f = 0, k = 0;
-            if (j <= 19){
-                f = (b & c) | ((~b) & d);
-                k = 0x5A827999;
+
+        uint32_t a = state.h[0], b = state.h[1], c = state.h[2], d = state.h[3], e = state.h[4];
+
+        for(uint8_t j = 0; j < 80; j += 5){
+            uint32_t W[5];
+            for(uint8_t x = 0; x < 5; x++){
+                const uint8_t t = j + x;
+                if (t >= 16){
+                    w[t & 15] = rol(w[(t - 3) & 15] ^ w[(t - 8) & 15] ^ w[(t - 14) & 15] ^ w[t & 15], 1);
+                }
+                W[x] = w[t & 15];
+            }
+
+            if (j < 20){
+                SHA1_ROUND(a, b, c, d, e, (d ^ (b & (c ^ d))), 0x5A827999, W[0]);
+                SHA1_ROUND(e, a, b, c, d, (c ^ (a & (b ^ c))), 0x5A827999, W[1]);
+                SHA1_ROUND(d, e, a, b, c, (b ^ (e & (a ^ b))), 0x5A827999, W[2]);
+                SHA1_ROUND(c, d, e, a, b, (a ^ (d & (e ^ a))), 0x5A827999, W[3]);
+                SHA1_ROUND(b, c, d, e, a, (e ^ (c & (d ^ e))), 0x5A827999, W[4]);
             }
-            if (20 <= j && j <= 39){
-                f = b ^ c ^ d;
-                k = 0x6ED9EBA1;
+            else if (j < 40){
+                SHA1_ROUND(a, b, c, d, e, (b ^ c ^ d), 0x6ED9EBA1, W[0]);
+                SHA1_ROUND(e, a, b, c, d, (a ^ b ^ c), 0x6ED9EBA1, W[1]);
+                SHA1_ROUND(d, e, a, b, c, (e ^ a ^ b), 0x6ED9EBA1, W[2]);
+                SHA1_ROUND(c, d, e, a, b, (d ^ e ^ a), 0x6ED9EBA1, W[3]);
+                SHA1_ROUND(b, c, d, e, a, (c ^ d ^ e), 0x6ED9EBA1, W[4]);
             }
-            if (40 <= j && j <= 59){
-                f = (b & c) | (b & d) | (c & d);
-                k = 0x8F1BBCDC;
+            else if (j < 60){
+                SHA1_ROUND(a, b, c, d, e, ((b & c) | (d & (b | c))), 0x8F1BBCDC, W[0]);
+                SHA1_ROUND(e, a, b, c, d, ((a & b) | (c & (a | b))), 0x8F1BBCDC, W[1]);
+                SHA1_ROUND(d, e, a, b, c, ((e & a) | (b & (e | a))), 0x8F1BBCDC, W[2]);
+                SHA1_ROUND(c, d, e, a, b, ((d & e) | (a & (d | e))), 0x8F1BBCDC, W[3]);
+                SHA1_ROUND(b, c, d, e, a, ((c & d) | (e & (c | d))), 0x8F1BBCDC, W[4]);
             }
-            if (60 <= j && j <= 79){
-                f = b ^ c ^ d;
-                k = 0xCA62C1D6;
+            else{
+                SHA1_ROUND(a, b, c, d, e, (b ^ c ^ d), 0xCA62C1D6, W[0]);
+                SHA1_ROUND(e, a, b, c, d, (a ^ b ^ c), 0xCA62C1D6, W[1]);
+                SHA1_ROUND(d, e, a, b, c, (e ^ a ^ b), 0xCA62C1D6, W[2]);
+                SHA1_ROUND(c, d, e, a, b, (d ^ e ^ a), 0xCA62C1D6, W[3]);
+                SHA1_ROUND(b, c, d, e, a, (c ^ d ^ e), 0xCA62C1D6, W[4]);
             }
-            uint32_t temp = ROL(a, 5, 32) + f + e + k + skey[j];
-            e = d;
-            d = c;
-            c = ROL(b, 30, 32);
-            b = a;
-            a = temp;
         }
-        state.h0 += a;
-        state.h1 += b;
-        state.h2 += c;
-        state.h3 += d;
-        state.h4 += e;
+
+        state.h[0] += a;
+        state.h[1] += b;
+        state.h[2] += c;
+        state.h[3] += d;
+        state.h[4] += e;
     }
 }
 
-SHA1::SHA1() :
-    MerkleDamgard(),
-    ctx(0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0)
-{}
+#undef SHA1_ROUND
 
-SHA1::SHA1(const std::string & str) :
-    SHA1()
-{
-    update(str);
+void SHA1::compress(const uint8_t * data, const std::size_t blocks){
+    calc(data, blocks, ctx);
 }
 
-void SHA1::update(const std::string & str){
-    std::string data = stack + str;
-    stack.clear();
-    std::string::size_type size = ((data.size() >> 6) << 6);
-    if ( std::string::size_type rem = ( data.size() - size ) ){
-        stack = data.substr(size, rem);
+void SHA1::calc_digest(uint8_t * out){
+    context tmp = ctx;
+    uint8_t last[128];
+    calc(last, pad(last, 8, true), tmp);
+    for(uint8_t x = 0; x < 5; x++){
+        store_big_endian(tmp.h[x], out + (x << 2));
     }
-    calc(data.substr(0, size), ctx);
-    clen += size;
+    wipe(last, sizeof(last));
 }
 
-std::string SHA1::hexdigest(){
-    context tmp = ctx;
-    uint16_t size = stack.size();
-    std::string last = stack + "\x80" + std::string((((size & 63) > 55)?119:55) - (size & 63), 0) + unhexlify(makehex((clen+size) << 3, 16));
-    calc(last, tmp);
-    return makehex(tmp.h0, 8) + makehex(tmp.h1, 8) + makehex(tmp.h2, 8) + makehex(tmp.h3, 8) + makehex(tmp.h4, 8);
+SHA1::SHA1(const Implementation implementation) :
+    MerkleDamgard(),
+    ctx(0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0),
+    impl(implementation)
+{
+    if ((impl == SHANI) && !SHANI::available()){
+        throw std::runtime_error("Error: SHA extensions are not supported by this CPU.");
+    }
+
+    if (impl == AUTO){
+        impl = SHANI::available()?SHANI:PORTABLE;
+    }
+}
+
+SHA1::SHA1(const std::string & str, const Implementation implementation) :
+    SHA1(implementation)
+{
+    update(str);
 }
 
 std::size_t SHA1::blocksize() const {
@@ -80,4 +120,12 @@ std::size_t SHA1::blocksize() const {
 
 std::size_t SHA1::digestsize() const {
     return 160;
+}
+
+MerkleDamgard::Ptr SHA1::clone() const {
+    return MerkleDamgard::Ptr(new SHA1(*this));
+}
+
+SHA1::Implementation SHA1::implementation() const {
+    return impl;
 }
\ No newline at end of file
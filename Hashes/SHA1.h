@@ -29,35 +29,49 @@ THE SOFTWARE.
 #include "../common/cryptomath.h"
 #include "../common/includes.h"
 #include "MerkleDamgard.h"
+#include "SHANI.h"
 
 class SHA1 : public MerkleDamgard {
+    public:
+        // which code runs the compression function
+        enum Implementation {
+            AUTO,       // SHANI if the CPU supports it, otherwise PORTABLE
+            PORTABLE,
+            SHANI,      // x86 SHA extensions
+        };
+
     private:
         struct context{
-            uint32_t h0, h1, h2, h3, h4;
+            uint32_t h[5];
 
             context(uint32_t h0, uint32_t h1, uint32_t h2, uint32_t h3, uint32_t h4) :
-                h0(h0),
-                h1(h1),
-                h2(h2),
-                h3(h3),
-                h4(h4)
+                h{h0, h1, h2, h3, h4}
             {}
             ~context(){
-                h0 = h1 = h2 = h3 = h4 = 0;
+                for(uint32_t & x : h){
+                    x = 0;
+                }
             }
         };
 
         context ctx;
+        Implementation impl;
 
-        void calc(const std::string & data, context & state) const;
+        // process complete 64 octet blocks
+        void calc(const uint8_t * data, const std::size_t blocks, context & state) const;
+
+        void compress(const uint8_t * data, const std::size_t blocks);
+        void calc_digest(uint8_t * out);
 
     public:
-        SHA1();
-        SHA1(const std::string & str);
-        void update(const std::string & str);
-        std::string hexdigest();
+        SHA1(const Implementation implementation = AUTO);
+        SHA1(const std::string & str, const Implementation implementation = AUTO);
+
+        // implementation selected by the constructor
+        Implementation implementation() const;
         std::size_t blocksize() const;
         std::size_t digestsize() const;
+        MerkleDamgard::Ptr clone() const;
 };
 
 #endif
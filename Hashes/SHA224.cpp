@@ -1,36 +1,36 @@
 #include "SHA224.h"
 
 void SHA224::original_h(){
-    ctx.h0 = 0xc1059ed8;
-    ctx.h1 = 0x367cd507;
-    ctx.h2 = 0x3070dd17;
-    ctx.h3 = 0xf70e5939;
-    ctx.h4 = 0xffc00b31;
-    ctx.h5 = 0x68581511;
-    ctx.h6 = 0x64f98fa7;
-    ctx.h7 = 0xbefa4fa4;
+    ctx.h[0] = 0xc1059ed8;
+    ctx.h[1] = 0x367cd507;
+    ctx.h[2] = 0x3070dd17;
+    ctx.h[3] = 0xf70e5939;
+    ctx.h[4] = 0xffc00b31;
+    ctx.h[5] = 0x68581511;
+    ctx.h[6] = 0x64f98fa7;
+    ctx.h[7] = 0xbefa4fa4;
 }
 
-SHA224::SHA224() :
-    SHA256()
+SHA224::SHA224(const Implementation implementation) :
+    SHA256(implementation)
 {
     original_h();
 }
 
-SHA224::SHA224(const std::string & str) :
-    SHA224()
+SHA224::SHA224(const std::string & str, const Implementation implementation) :
+    SHA224(implementation)
 {
     update(str);
 }
 
-std::string SHA224::hexdigest(){
-    return SHA256::hexdigest().substr(0, 56);
-}
-
 std::size_t SHA224::blocksize() const {
     return 512;
 }
 
 std::size_t SHA224::digestsize() const {
     return 224;
+}
+
+MerkleDamgard::Ptr SHA224::clone() const {
+    return MerkleDamgard::Ptr(new SHA224(*this));
 }
\ No newline at end of file
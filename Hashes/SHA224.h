@@ -33,11 +33,11 @@ class SHA224 : public SHA256 {
         void original_h();
 
     public:
-        SHA224();
-        SHA224(const std::string & data);
-        std::string hexdigest();
+        SHA224(const Implementation implementation = AUTO);
+        SHA224(const std::string & data, const Implementation implementation = AUTO);
         std::size_t blocksize() const;
         std::size_t digestsize() const;
+        MerkleDamgard::Ptr clone() const;
 };
 
 #endif
@@ -17,27 +17,37 @@ uint32_t SHA256::s1(const uint32_t & value) const {
 }
 
 void SHA256::original_h(){
-    ctx.h0 = 0x6a09e667;
-    ctx.h1 = 0xbb67ae85;
-    ctx.h2 = 0x3c6ef372;
-    ctx.h3 = 0xa54ff53a;
-    ctx.h4 = 0x510e527f;
-    ctx.h5 = 0x9b05688c;
-    ctx.h6 = 0x1f83d9ab;
-    ctx.h7 = 0x5be0cd19;
+    ctx.h[0] = 0x6a09e667;
+    ctx.h[1] = 0xbb67ae85;
+    ctx.h[2] = 0x3c6ef372;
+    ctx.h[3] = 0xa54ff53a;
+    ctx.h[4] = 0x510e527f;
+    ctx.h[5] = 0x9b05688c;
+    ctx.h[6] = 0x1f83d9ab;
+    ctx.h[7] = 0x5be0cd19;
 }
 
-void SHA256::calc(const std::string &data, context &state) const {
-    for(unsigned int n = 0; n < (data.size() >> 6); n++){
-        std::string temp = data.substr(n << 6, 64);
+void SHA256::calc(const uint8_t * data, const std::size_t blocks, context & state) const {
+    if (impl == SHANI){
+        SHANI::sha256_blocks(state.h, data, blocks);
+        return;
+    }
+
+    if (impl == AVX2){
+        SHA2_AVX2::sha256_blocks(state.h, data, blocks);
+        return;
+    }
+
+    for(std::size_t n = 0; n < blocks; n++){
+        const uint8_t * block = data + (n << 6);
         uint32_t skey[64];
         for(uint8_t x = 0; x < 16; x++){
-            skey[x] = toint(temp.substr(x << 2, 4), 256);
+            skey[x] = load_big_endian <uint32_t> (block + (x << 2));
         }
         for(uint8_t x = 16; x < 64; x++){
             skey[x] = s1(skey[x - 2]) + skey[x - 7] + s0(skey[x - 15]) + skey[x - 16];
         }
-        uint32_t a = state.h0, b = state.h1, c = state.h2, d = state.h3, e = state.h4, f = state.h5, g = state.h6, h = state.h7;
+        uint32_t a = state.h[0], b = state.h[1], c = state.h[2], d = state.h[3], e = state.h[4], f = state.h[5], g = state.h[6], h = state.h[7];
         for(uint8_t x = 0; x < 64; x++){
             uint32_t t1 = h + S1(e) + Ch(e, f, g) + SHA256_K[x] + skey[x];
             uint32_t t2 = S0(a) + Maj(a, b, c);
@@ -50,40 +60,48 @@ void SHA256::calc(const std::string &data, context &state) const {
             b = a;
             a = t1 + t2;
         }
-        state.h0 += a; state.h1 += b; state.h2 += c; state.h3 += d; state.h4 += e; state.h5 += f; state.h6 += g; state.h7 += h;
+        state.h[0] += a; state.h[1] += b; state.h[2] += c; state.h[3] += d; state.h[4] += e; state.h[5] += f; state.h[6] += g; state.h[7] += h;
     }
 }
 
-SHA256::SHA256() :
-    MerkleDamgard(),
-    ctx()
-{
-    original_h();
+void SHA256::compress(const uint8_t * data, const std::size_t blocks){
+    calc(data, blocks, ctx);
 }
 
-SHA256::SHA256(const std::string & str) :
-    SHA256()
-{
-    update(str);
+void SHA256::calc_digest(uint8_t * out){
+    context tmp = ctx;
+    uint8_t last[128];
+    calc(last, pad(last, 8, true), tmp);
+    for(std::size_t x = 0; x < (digestsize() >> 5); x++){
+        store_big_endian(tmp.h[x], out + (x << 2));
+    }
+    wipe(last, sizeof(last));
 }
 
-void SHA256::update(const std::string &str){
-    std::string data = stack + str;
-    stack.clear();
-    std::string::size_type size = ((data.size() >> 6) << 6);
-    if ( std::string::size_type rem = ( data.size() - size ) ){
-        stack = data.substr(size, rem);
+SHA256::SHA256(const Implementation implementation) :
+    MerkleDamgard(),
+    ctx(),
+    impl(implementation)
+{
+    if ((impl == SHANI) && !SHANI::available()){
+        throw std::runtime_error("Error: SHA extensions are not supported by this CPU.");
+    }
+
+    if ((impl == AVX2) && !SHA2_AVX2::available()){
+        throw std::runtime_error("Error: AVX2 is not supported by this CPU.");
+    }
+
+    if (impl == AUTO){
+        impl = SHANI::available()?SHANI:(SHA2_AVX2::available()?AVX2:PORTABLE);
     }
-    calc(data.substr(0, size), ctx);
-    clen += size;
+
+    original_h();
 }
 
-std::string SHA256::hexdigest(){
-    context tmp = ctx;
-    uint32_t size = stack.size();
-    std::string last = stack + "\x80" + std::string((((size & 63) > 55)?119:55) - (size & 63), 0) + unhexlify(makehex((clen+size) << 3, 16));
-    calc(last, tmp);
-    return makehex(tmp.h0, 8) + makehex(tmp.h1, 8) + makehex(tmp.h2, 8) + makehex(tmp.h3, 8) + makehex(tmp.h4, 8) + makehex(tmp.h5, 8) + makehex(tmp.h6, 8) + makehex(tmp.h7, 8);
+SHA256::SHA256(const std::string & str, const Implementation implementation) :
+    SHA256(implementation)
+{
+    update(str);
 }
 
 std::size_t SHA256::blocksize() const {
@@ -92,4 +110,12 @@ std::size_t SHA256::blocksize() const {
 
 std::size_t SHA256::digestsize() const {
     return 256;
+}
+
+MerkleDamgard::Ptr SHA256::clone() const {
+    return MerkleDamgard::Ptr(new SHA256(*this));
+}
+
+SHA256::Implementation SHA256::implementation() const {
+    return impl;
 }
\ No newline at end of file
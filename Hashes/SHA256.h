@@ -30,19 +30,33 @@ THE SOFTWARE.
 #include "../common/includes.h"
 #include "MerkleDamgard.h"
 
+#include "SHA2_AVX2.h"
 #include "SHA2_Functions.h"
 #include "SHA256_Const.h"
+#include "SHANI.h"
 
 class SHA256 : public MerkleDamgard {
+    public:
+        // which code runs the compression function
+        enum Implementation {
+            AUTO,       // fastest one supported by the CPU
+            PORTABLE,
+            AVX2,       // message schedule in AVX2 registers
+            SHANI,      // x86 SHA extensions
+        };
+
     protected:
         struct context{
-            uint32_t h0, h1, h2, h3, h4, h5, h6, h7;
+            uint32_t h[8];
 
             ~context(){
-                h0 = h1 = h2 = h3 = h4 = h5 = h6 = h7 = 0;
+                for(uint32_t & x : h){
+                    x = 0;
+                }
             }
         };
         context ctx;
+        Implementation impl;
 
         uint32_t S0(const uint32_t & value) const;
         uint32_t S1(const uint32_t & value) const;
@@ -51,16 +65,23 @@ class SHA256 : public MerkleDamgard {
 
         virtual void original_h();
 
-        void calc(const std::string & data, context & state) const;
+        // process complete 64 octet blocks
+        void calc(const uint8_t * data, const std::size_t blocks, context & state) const;
+
+        void compress(const uint8_t * data, const std::size_t blocks);
+
+        // writes the first digestsize() / 32 words
+        void calc_digest(uint8_t * out);
 
     public:
-        SHA256();
-        SHA256(const std::string & data);
+        SHA256(const Implementation implementation = AUTO);
+        SHA256(const std::string & data, const Implementation implementation = AUTO);
 
-        void update(const std::string &str);
-        virtual std::string hexdigest();
+        // implementation selected by the constructor
+        Implementation implementation() const;
         virtual std::size_t blocksize() const;
         virtual std::size_t digestsize() const;
+        virtual MerkleDamgard::Ptr clone() const;
 };
 
 #endif
@@ -0,0 +1,230 @@
+#include "SHA2_AVX2.h"
+
+#include <stdexcept>
+
+#include "SHA256_Const.h"
+#include "SHA512_Const.h"
+#include "../common/CPU.h"
+
+#ifdef CPU_X86
+#define SHA2_AVX2_SUPPORTED
+#endif
+
+#ifdef SHA2_AVX2_SUPPORTED
+
+#include <immintrin.h>
+
+#define SHA2_AVX2_TARGET __attribute__((target("avx2")))
+
+namespace SHA2_AVX2 {
+
+namespace {
+
+uint32_t ror(const uint32_t x, const uint8_t n){
+    return (x >> n) | (x << (32 - n));
+}
+
+uint64_t ror(const uint64_t x, const uint8_t n){
+    return (x >> n) | (x << (64 - n));
+}
+
+SHA2_AVX2_TARGET
+__m256i ror32(const __m256i x, const int n){
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+SHA2_AVX2_TARGET
+__m256i s0_256(const __m256i x){
+    return _mm256_xor_si256(_mm256_xor_si256(ror32(x, 7), ror32(x, 18)), _mm256_srli_epi32(x, 3));
+}
+
+SHA2_AVX2_TARGET
+__m256i s1_256(const __m256i x){
+    return _mm256_xor_si256(_mm256_xor_si256(ror32(x, 17), ror32(x, 19)), _mm256_srli_epi32(x, 10));
+}
+
+// W[t] + K[t] for two blocks, block 0 in the low lane and block 1 in the high lane
+SHA2_AVX2_TARGET
+void sha256_schedule(const uint8_t * block0, const uint8_t * block1, uint32_t wk[2][64]){
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                           0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const __m256i LOW  = _mm256_set_epi32(0, 0, -1, -1, 0, 0, -1, -1);
+    const __m256i HIGH = _mm256_set_epi32(-1, -1, 0, 0, -1, -1, 0, 0);
+
+    __m256i X[4];
+    for(uint8_t i = 0; i < 4; i++){
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast <const __m128i *> (block0 + (i << 4)));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast <const __m128i *> (block1 + (i << 4)));
+        X[i] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), MASK);
+    }
+
+    for(uint8_t t = 0; t < 64; t += 4){
+        __m256i w = X[0];
+        if (t >= 16){
+            // W[t - 16] + s0(W[t - 15]) + W[t - 7]
+            w = _mm256_add_epi32(w, s0_256(_mm256_alignr_epi8(X[1], X[0], 4)));
+            w = _mm256_add_epi32(w, _mm256_alignr_epi8(X[3], X[2], 4));
+
+            // s1(W[t - 2]) is only known for the first 2 words until they are done
+            w = _mm256_add_epi32(w, _mm256_and_si256(s1_256(_mm256_shuffle_epi32(X[3], 0xFE)), LOW));
+            w = _mm256_add_epi32(w, _mm256_and_si256(s1_256(_mm256_shuffle_epi32(w, 0x40)), HIGH));
+
+            X[0] = X[1];
+            X[1] = X[2];
+            X[2] = X[3];
+            X[3] = w;
+        }
+        else{
+            w = X[t >> 2];
+        }
+
+        const __m256i k = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast <const __m128i *> (SHA256_K + t)));
+        w = _mm256_add_epi32(w, k);
+        _mm_storeu_si128(reinterpret_cast <__m128i *> (wk[0] + t), _mm256_castsi256_si128(w));
+        _mm_storeu_si128(reinterpret_cast <__m128i *> (wk[1] + t), _mm256_extracti128_si256(w, 1));
+    }
+}
+
+// AVX2 has no 64 bit rotate
+SHA2_AVX2_TARGET
+__m256i ror64(const __m256i x, const int n){
+    return _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - n));
+}
+
+SHA2_AVX2_TARGET
+__m256i s0_512(const __m256i x){
+    return _mm256_xor_si256(_mm256_xor_si256(ror64(x, 1), ror64(x, 8)), _mm256_srli_epi64(x, 7));
+}
+
+SHA2_AVX2_TARGET
+__m256i s1_512(const __m256i x){
+    return _mm256_xor_si256(_mm256_xor_si256(ror64(x, 19), ror64(x, 61)), _mm256_srli_epi64(x, 6));
+}
+
+// words 1 - 3 of a followed by word 0 of b
+SHA2_AVX2_TARGET
+__m256i next64(const __m256i a, const __m256i b){
+    return _mm256_alignr_epi8(_mm256_permute2x128_si256(a, b, 0x21), a, 8);
+}
+
+// W[t] + K[t] for one block
+SHA2_AVX2_TARGET
+void sha512_schedule(const uint8_t * block, uint64_t wk[80]){
+    const __m256i MASK = _mm256_set_epi64x(0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
+                                           0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+    const __m256i LOW  = _mm256_set_epi64x(0, 0, -1, -1);
+    const __m256i HIGH = _mm256_set_epi64x(-1, -1, 0, 0);
+
+    __m256i X[4];
+    for(uint8_t i = 0; i < 4; i++){
+        X[i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast <const __m256i *> (block + (i << 5))), MASK);
+    }
+
+    for(uint8_t t = 0; t < 80; t += 4){
+        __m256i w;
+        if (t >= 16){
+            // W[t - 16] + s0(W[t - 15]) + W[t - 7]
+            w = _mm256_add_epi64(X[0], s0_512(next64(X[0], X[1])));
+            w = _mm256_add_epi64(w, next64(X[2], X[3]));
+
+            // s1(W[t - 2]) is only known for the first 2 words until they are done
+            w = _mm256_add_epi64(w, _mm256_and_si256(s1_512(_mm256_permute4x64_epi64(X[3], 0xEE)), LOW));
+            w = _mm256_add_epi64(w, _mm256_and_si256(s1_512(_mm256_permute4x64_epi64(w, 0x44)), HIGH));
+
+            X[0] = X[1];
+            X[1] = X[2];
+            X[2] = X[3];
+            X[3] = w;
+        }
+        else{
+            w = X[t >> 2];
+        }
+
+        w = _mm256_add_epi64(w, _mm256_loadu_si256(reinterpret_cast <const __m256i *> (SHA512_K + t)));
+        _mm256_storeu_si256(reinterpret_cast <__m256i *> (wk + t), w);
+    }
+}
+
+void sha512_rounds(uint64_t * state, const uint64_t * wk){
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+    for(uint8_t x = 0; x < 80; x++){
+        const uint64_t t1 = h + (ror(e, 14) ^ ror(e, 18) ^ ror(e, 41)) + ((e & f) ^ (~e & g)) + wk[x];
+        const uint64_t t2 = (ror(a, 28) ^ ror(a, 34) ^ ror(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void sha256_rounds(uint32_t * state, const uint32_t * wk){
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+    for(uint8_t x = 0; x < 64; x++){
+        const uint32_t t1 = h + (ror(e, 6) ^ ror(e, 11) ^ ror(e, 25)) + ((e & f) ^ (~e & g)) + wk[x];
+        const uint32_t t2 = (ror(a, 2) ^ ror(a, 13) ^ ror(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+}
+
+bool available(){
+    return OpenPGP::CPU::avx2();
+}
+
+void sha256_blocks(uint32_t * state, const uint8_t * data, const std::size_t blocks){
+    uint32_t wk[2][64];
+    for(std::size_t n = 0; n < blocks; n += 2){
+        // an odd block at the end is scheduled twice
+        const uint8_t * block0 = data + (n << 6);
+        const uint8_t * block1 = ((n + 1) < blocks)?(block0 + 64):block0;
+        sha256_schedule(block0, block1, wk);
+        sha256_rounds(state, wk[0]);
+        if ((n + 1) < blocks){
+            sha256_rounds(state, wk[1]);
+        }
+    }
+}
+
+void sha512_blocks(uint64_t * state, const uint8_t * data, const std::size_t blocks){
+    uint64_t wk[80];
+    for(std::size_t n = 0; n < blocks; n++){
+        sha512_schedule(data + (n << 7), wk);
+        sha512_rounds(state, wk);
+    }
+}
+
+}
+
+#else
+
+namespace SHA2_AVX2 {
+
+bool available(){
+    return false;
+}
+
+void sha256_blocks(uint32_t *, const uint8_t *, const std::size_t){
+    throw std::runtime_error("Error: AVX2 is not supported on this platform.");
+}
+
+void sha512_blocks(uint64_t *, const uint8_t *, const std::size_t){
+    throw std::runtime_error("Error: AVX2 is not supported on this platform.");
+}
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+SHA2_AVX2.h
+SHA2 message schedules using AVX2
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __SHA2_AVX2__
+#define __SHA2_AVX2__
+
+#include <cstddef>
+#include <cstdint>
+
+// SHA2 compression functions with the message schedule computed in AVX2
+// registers. SHA-256 schedules two blocks at a time (one per 128 bit lane),
+// SHA-512 schedules four 64 bit words of one block at a time. The rounds
+// themselves are serial and stay scalar.
+//
+// Everything here only works if available() returns true.
+namespace SHA2_AVX2 {
+    // whether or not the current CPU and OS support AVX2
+    bool available();
+
+    // state holds h0 - h7, data holds blocks complete 64 octet blocks
+    void sha256_blocks(uint32_t * state, const uint8_t * data, const std::size_t blocks);
+
+    // state holds h0 - h7, data holds blocks complete 128 octet blocks
+    void sha512_blocks(uint64_t * state, const uint8_t * data, const std::size_t blocks);
+}
+
+#endif
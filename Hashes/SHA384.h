@@ -33,11 +33,11 @@ class SHA384 : public SHA512 {
         void original_h();
 
     public:
-        SHA384();
-        SHA384(const std::string & data);
-        std::string hexdigest();
+        SHA384(const Implementation implementation = AUTO);
+        SHA384(const std::string & data, const Implementation implementation = AUTO);
         std::size_t blocksize() const;
         std::size_t digestsize() const;
+        MerkleDamgard::Ptr clone() const;
 };
 
 #endif
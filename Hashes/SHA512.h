@@ -30,35 +30,56 @@ THE SOFTWARE.
 #include "../common/includes.h"
 #include "MerkleDamgard.h"
 
+#include "SHA2_AVX2.h"
 #include "SHA2_Functions.h"
 #include "SHA512_Const.h"
 
 class SHA512 : public MerkleDamgard {
+    public:
+        // which code runs the compression function
+        enum Implementation {
+            AUTO,       // AVX2 if the CPU supports it, otherwise PORTABLE
+            PORTABLE,
+            AVX2,       // message schedule in AVX2 registers
+        };
+
     protected:
         struct context{
-            uint64_t h0, h1, h2, h3, h4, h5, h6, h7;
+            uint64_t h[8];
+
             ~context(){
-                h0 = h1 = h2 = h3 = h4 = h5 = h6 = h7 = 0;
+                for(uint64_t & x : h){
+                    x = 0;
+                }
             }
         };
         context ctx;
+        Implementation impl;
 
-        uint64_t S0(uint64_t & value) const;
-        uint64_t S1(uint64_t & value) const;
-        uint64_t s0(uint64_t & value) const;
-        uint64_t s1(uint64_t & value) const;
+        uint64_t S0(const uint64_t & value) const;
+        uint64_t S1(const uint64_t & value) const;
+        uint64_t s0(const uint64_t & value) const;
+        uint64_t s1(const uint64_t & value) const;
 
         virtual void original_h();
 
-        void calc(const std::string & data, context & state) const;
+        // process complete 128 octet blocks
+        void calc(const uint8_t * data, const std::size_t blocks, context & state) const;
+
+        void compress(const uint8_t * data, const std::size_t blocks);
+
+        // writes the first digestsize() / 64 words
+        void calc_digest(uint8_t * out);
 
     public:
-        SHA512();
-        SHA512(const std::string & data);
-        void update(const std::string & str);
-        virtual std::string hexdigest();
+        SHA512(const Implementation implementation = AUTO);
+        SHA512(const std::string & data, const Implementation implementation = AUTO);
+
+        // implementation selected by the constructor
+        Implementation implementation() const;
         virtual std::size_t blocksize() const;
         virtual std::size_t digestsize() const;
+        virtual MerkleDamgard::Ptr clone() const;
 };
 
 #endif
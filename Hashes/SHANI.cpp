@@ -0,0 +1,164 @@
+#include "SHANI.h"
+
+#include <stdexcept>
+
+#include "SHA256_Const.h"
+#include "../common/CPU.h"
+
+#ifdef CPU_X86
+#define SHANI_SUPPORTED
+#endif
+
+#ifdef SHANI_SUPPORTED
+
+#include <immintrin.h>
+
+#define SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+namespace SHANI {
+
+bool available(){
+    return OpenPGP::CPU::ssse3() && OpenPGP::CPU::sse41() && OpenPGP::CPU::sha();
+}
+
+SHANI_TARGET
+void sha1_blocks(uint32_t * state, const uint8_t * data, const std::size_t blocks){
+    // big endian words, with the first word in the highest element
+    const __m128i MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast <const __m128i *> (state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+    __m128i e1;
+
+    for(std::size_t n = 0; n < blocks; n++){
+        const __m128i * block = reinterpret_cast <const __m128i *> (data + (n << 6));
+        const __m128i abcd_save = abcd;
+        const __m128i e_save = e0;
+
+        // 20 groups of 4 rounds; group g uses W[4g, 4g + 4)
+        __m128i msg[4];
+        for(uint8_t g = 0; g < 20; g++){
+            if (g < 4){
+                msg[g] = _mm_shuffle_epi8(_mm_loadu_si128(block + g), MASK);
+            }
+
+            // E for this group comes from A of the group before last, kept in alternating registers
+            __m128i & e = (g & 1)?e1:e0;
+            __m128i & next_e = (g & 1)?e0:e1;
+            if (g == 0){
+                e = _mm_add_epi32(e, msg[0]);
+            }
+            else{
+                e = _mm_sha1nexte_epu32(e, msg[g & 3]);
+            }
+            next_e = abcd;
+
+            // group g + 1 is finished with W[4g, 4g + 4)
+            if ((g >= 3) && (g < 19)){
+                msg[(g + 1) & 3] = _mm_sha1msg2_epu32(msg[(g + 1) & 3], msg[g & 3]);
+            }
+
+            switch (g / 5){
+                case 0: abcd = _mm_sha1rnds4_epu32(abcd, e, 0); break;
+                case 1: abcd = _mm_sha1rnds4_epu32(abcd, e, 1); break;
+                case 2: abcd = _mm_sha1rnds4_epu32(abcd, e, 2); break;
+                default: abcd = _mm_sha1rnds4_epu32(abcd, e, 3); break;
+            }
+
+            // group g + 3 starts from W[4g - 4, 4g + 4)
+            if ((g >= 1) && (g < 17)){
+                msg[(g + 3) & 3] = _mm_sha1msg1_epu32(msg[(g + 3) & 3], msg[g & 3]);
+            }
+
+            // group g + 2 takes W[4g, 4g + 4) as its W[t - 8]
+            if ((g >= 2) && (g < 18)){
+                msg[(g + 2) & 3] = _mm_xor_si128(msg[(g + 2) & 3], msg[g & 3]);
+            }
+        }
+
+        // after the last group, e0 holds A from the group before it
+        e0 = _mm_sha1nexte_epu32(e0, e_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    _mm_storeu_si128(reinterpret_cast <__m128i *> (state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = _mm_extract_epi32(e0, 3);
+}
+
+SHANI_TARGET
+void sha256_blocks(uint32_t * state, const uint8_t * data, const std::size_t blocks){
+    // big endian words
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // the instructions want the state as ABEF and CDGH
+    __m128i tmp    = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast <const __m128i *> (state)), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast <const __m128i *> (state + 4)), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for(std::size_t n = 0; n < blocks; n++){
+        const __m128i * block = reinterpret_cast <const __m128i *> (data + (n << 6));
+        const __m128i abef = state0;
+        const __m128i cdgh = state1;
+
+        __m128i msg[4];
+        for(uint8_t g = 0; g < 16; g++){
+            if (g < 4){
+                msg[g] = _mm_shuffle_epi8(_mm_loadu_si128(block + g), MASK);
+            }
+
+            // 2 rounds with the low half of W + K, then 2 with the high half
+            __m128i wk = _mm_add_epi32(msg[g & 3], _mm_loadu_si128(reinterpret_cast <const __m128i *> (SHA256_K + (g << 2))));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+
+            // finish the schedule for the next group of 4 words
+            if ((g >= 3) && (g < 15)){
+                __m128i & next = msg[(g + 1) & 3];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(msg[g & 3], msg[(g - 1) & 3], 4));
+                next = _mm_sha256msg2_epu32(next, msg[g & 3]);
+            }
+
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+
+            // start the schedule for 3 groups ahead
+            if ((g >= 1) && (g < 13)){
+                msg[(g - 1) & 3] = _mm_sha256msg1_epu32(msg[(g - 1) & 3], msg[g & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    // back to ABCD and EFGH
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128(reinterpret_cast <__m128i *> (state), state0);
+    _mm_storeu_si128(reinterpret_cast <__m128i *> (state + 4), state1);
+}
+
+}
+
+#else
+
+namespace SHANI {
+
+bool available(){
+    return false;
+}
+
+void sha1_blocks(uint32_t *, const uint8_t *, const std::size_t){
+    throw std::runtime_error("Error: SHA extensions are not supported on this platform.");
+}
+
+void sha256_blocks(uint32_t *, const uint8_t *, const std::size_t){
+    throw std::runtime_error("Error: SHA extensions are not supported on this platform.");
+}
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+SHANI.h
+SHA using the x86 SHA extensions
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __SHANI__
+#define __SHANI__
+
+#include <cstddef>
+#include <cstdint>
+
+// SHA compression functions using the x86 SHA extensions
+//
+// state holds the chaining values in the usual order (h0 first) and data
+// holds blocks complete 64 octet blocks.
+// SHA-1 uses 5 chaining values and SHA-256 uses 8.
+//
+// Everything here only works if available() returns true.
+namespace SHANI {
+    // whether or not the current CPU supports the SHA extensions
+    bool available();
+
+    void sha1_blocks(uint32_t * state, const uint8_t * data, const std::size_t blocks);
+    void sha256_blocks(uint32_t * state, const uint8_t * data, const std::size_t blocks);
+}
+
+#endif
@@ -2,10 +2,13 @@ HASHES_OBJECTS=Hashes.o               \
                HashAlg.o              \
                MerkleDamgard.o        \
                MD5.o                  \
+               MultiBuffer.o          \
                RIPEMD160.o            \
                SHA1.o                 \
+               SHA2_AVX2.o            \
                SHA224.o               \
                SHA256.o               \
                SHA2_Functions.o       \
                SHA384.o               \
-               SHA512.o
+               SHA512.o               \
+               SHANI.o
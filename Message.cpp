@@ -214,26 +214,32 @@ std::string Message::raw(const Packet::Tag::Format header) const{
     return out;
 }
 
-std::string Message::write(const PGP::Armored armor, const Packet::Tag::Format header) const{
+void Message::write(std::ostream & stream, const PGP::Armored armor, const Packet::Tag::Format header) const{
+    // without compression, packets are written one at a time
+    if (!comp){
+        PGP::write(stream, armor, header);
+        return;
+    }
+
+    // the compressor needs every packet at once
     std::string packet_string = raw(header);
 
     // put data into a Compressed Data Packet if compression is used
     if (comp){
         comp -> set_data(packet_string);
         packet_string = comp -> write(header);
+        comp -> set_data("");   // hold compressed data for as little time as possible
     }
 
     if ((armor == Armored::NO)                   || // no armor
         ((armor == Armored::DEFAULT) && !armored)){ // or use stored value, and stored value is no
-        return packet_string;
+        stream << packet_string;
+        return;
     }
 
-    std::string out = "-----BEGIN PGP MESSAGE-----\n";
-    for(Armor_Key const & key : keys){
-        out += key.first + ": " + key.second + "\n";
-    }
-    out += "\n";
-    return out + format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH) + "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) +  "\n-----END PGP MESSAGE-----\n";
+    ArmorWriter writer(stream, ASCII_Armor_Header[MESSAGE], keys);
+    writer.sputn(packet_string.data(), packet_string.size());
+    writer.close();
 }
 
 uint8_t Message::get_comp() const{
@@ -1,24 +1,165 @@
 #include "CRC-24.h"
 
+#include "../common/CPU.h"
+
+#ifdef CPU_X86
+#define CRC24_PCLMUL_SUPPORTED
+#endif
+
+#ifdef CRC24_PCLMUL_SUPPORTED
+#include <immintrin.h>
+
+#define CRC24_PCLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+#endif
+
 namespace OpenPGP {
 
-// OpenPGP has an optional CRC24 checksum at the end of its Radix-64 encoded data
-uint32_t crc24(const std::string & str){
-    static const uint32_t INIT = 0xB704CE;
-    static const uint32_t POLY = 0x1864CFB;
-
-    uint32_t crc = INIT;
-    for(unsigned char const c : str){
-        crc ^= static_cast <uint32_t> (c) << 16;
-        for(uint8_t i = 0; i < 8; i++){
-            crc <<= 1;
-            if (crc & 0x1000000){
-                crc ^= POLY;
+namespace {
+
+const uint32_t POLY = 0x1864CFB;
+
+// The CRC is kept in the top 24 bits of a 32 bit register so that
+// the usual MSB-first slicing-by-8 tables can be used.
+struct Tables{
+    uint32_t t[8][256];
+
+    Tables(){
+        for(uint32_t i = 0; i < 256; i++){
+            uint32_t crc = i << 24;
+            for(uint8_t j = 0; j < 8; j++){
+                crc = (crc << 1) ^ ((crc & 0x80000000)?(POLY << 8):0);
+            }
+            t[0][i] = crc;
+        }
+        for(uint32_t i = 0; i < 256; i++){
+            for(uint8_t k = 1; k < 8; k++){
+                t[k][i] = (t[k - 1][i] << 8) ^ t[0][t[k - 1][i] >> 24];
             }
         }
     }
+};
+
+const Tables & tables(){
+    static const Tables tables;
+    return tables;
+}
+
+// crc is left aligned
+uint32_t slicing_by_8(uint32_t crc, const uint8_t * data, std::size_t len){
+    const Tables & T = tables();
+
+    for(; len >= 8; data += 8, len -= 8){
+        const uint32_t a = crc ^ load_big_endian <uint32_t> (data);
+        const uint32_t b = load_big_endian <uint32_t> (data + 4);
+        crc = T.t[7][a >> 24] ^ T.t[6][(a >> 16) & 0xff] ^ T.t[5][(a >> 8) & 0xff] ^ T.t[4][a & 0xff] ^
+              T.t[3][b >> 24] ^ T.t[2][(b >> 16) & 0xff] ^ T.t[1][(b >> 8) & 0xff] ^ T.t[0][b & 0xff];
+    }
+
+    while (len--){
+        crc = (crc << 8) ^ T.t[0][(crc >> 24) ^ *data++];
+    }
+
+    return crc;
+}
+
+#ifdef CRC24_PCLMUL_SUPPORTED
+
+bool pclmul_available(){
+    return CPU::pclmul() && CPU::ssse3();
+}
+
+// x^n mod P
+uint64_t xpow(const unsigned int n){
+    uint32_t r = 1;
+    for(unsigned int i = 0; i < n; i++){
+        r <<= 1;
+        if (r & 0x1000000){
+            r ^= POLY;
+        }
+    }
+    return r;
+}
+
+// Folding (Gopal et al., "Fast CRC Computation for Generic Polynomials Using
+// PCLMULQDQ"): a 128 bit block A = H * x^64 + L that is followed by n more bits
+// is congruent to H * (x^(n + 64) mod P) + L * (x^n mod P). The constants are
+// under 24 bits, so each product fits in 128 bits without a reduction step.
+struct Constants{
+    __m128i fold512;    // 4 blocks ahead
+    __m128i fold384;
+    __m128i fold256;
+    __m128i fold128;    // 1 block ahead
+
+    Constants()
+        : fold512(_mm_set_epi64x(xpow(512 + 64), xpow(512))),
+          fold384(_mm_set_epi64x(xpow(384 + 64), xpow(384))),
+          fold256(_mm_set_epi64x(xpow(256 + 64), xpow(256))),
+          fold128(_mm_set_epi64x(xpow(128 + 64), xpow(128)))
+    {}
+};
+
+CRC24_PCLMUL_TARGET
+__m128i fold(const __m128i a, const __m128i k){
+    return _mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x11), _mm_clmulepi64_si128(a, k, 0x00));
+}
+
+// processes a multiple of 16 octets, at least 64
+CRC24_PCLMUL_TARGET
+uint32_t pclmul(const uint32_t crc, const uint8_t * data, std::size_t len){
+    static const Constants K;
+
+    // octet 0 becomes the most significant
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i * in = reinterpret_cast <const __m128i *> (data);
+
+    // xoring the state into the first octets continues the CRC
+    __m128i a0 = _mm_xor_si128(_mm_shuffle_epi8(_mm_loadu_si128(in++), reverse), _mm_set_epi32(crc, 0, 0, 0));
+    __m128i a1 = _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse);
+    __m128i a2 = _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse);
+    __m128i a3 = _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse);
+    len -= 64;
+
+    for(; len >= 64; len -= 64){
+        a0 = _mm_xor_si128(fold(a0, K.fold512), _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse));
+        a1 = _mm_xor_si128(fold(a1, K.fold512), _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse));
+        a2 = _mm_xor_si128(fold(a2, K.fold512), _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse));
+        a3 = _mm_xor_si128(fold(a3, K.fold512), _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse));
+    }
+
+    __m128i a = _mm_xor_si128(_mm_xor_si128(fold(a0, K.fold384), fold(a1, K.fold256)), _mm_xor_si128(fold(a2, K.fold128), a3));
+
+    for(; len >= 16; len -= 16){
+        a = _mm_xor_si128(fold(a, K.fold128), _mm_shuffle_epi8(_mm_loadu_si128(in++), reverse));
+    }
 
-    return crc & 0xFFFFFF;
+    // the remaining 128 bits are small enough for the table
+    uint8_t last[16];
+    _mm_storeu_si128(reinterpret_cast <__m128i *> (last), _mm_shuffle_epi8(a, reverse));
+    return slicing_by_8(0, last, sizeof(last));
 }
 
-}
\ No newline at end of file
+#endif
+
+}
+
+uint32_t crc24_update(uint32_t crc, const uint8_t * data, std::size_t len){
+    crc <<= 8;
+
+    #ifdef CRC24_PCLMUL_SUPPORTED
+    if ((len >= 64) && pclmul_available()){
+        const std::size_t blocks = len & ~static_cast <std::size_t> (15);
+        crc = pclmul(crc, data, blocks);
+        data += blocks;
+        len -= blocks;
+    }
+    #endif
+
+    return slicing_by_8(crc, data, len) >> 8;
+}
+
+// OpenPGP has an optional CRC24 checksum at the end of its Radix-64 encoded data
+uint32_t crc24(const std::string & str){
+    return crc24_update(CRC24_INIT, reinterpret_cast <const uint8_t *> (str.data()), str.size());
+}
+
+}
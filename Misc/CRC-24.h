@@ -26,9 +26,12 @@ THE SOFTWARE.
 #ifndef __CRC24__
 #define __CRC24__
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
+#include "../common/includes.h"
+
 namespace OpenPGP {
     // 6.1.  An Implementation of the CRC-24 in "C"
     //
@@ -50,6 +53,12 @@ namespace OpenPGP {
     //           }
     //           return crc & 0xFFFFFFL;
     //       }
+    const uint32_t CRC24_INIT = 0xB704CE;
+
+    // continue a CRC-24 over len more octets; start with CRC24_INIT
+    // crc24_update(crc24_update(CRC24_INIT, a, n), b, m) == crc24(a || b)
+    uint32_t crc24_update(uint32_t crc, const uint8_t * data, std::size_t len);
+
     uint32_t crc24(const std::string & str);
 }
 
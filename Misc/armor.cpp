@@ -0,0 +1,179 @@
+#include "armor.h"
+
+#include <algorithm>
+
+namespace OpenPGP {
+
+bool ArmorReader::next_line(){
+    std::string line;
+    while (!done){
+        if (!std::getline(in, line) || (line.substr(0, 13) == "-----END PGP ")){
+            done = true;
+            break;
+        }
+
+        // tolerate CRLF line endings and trailing whitespace
+        const std::string::size_type end = line.find_last_not_of(" \t\r");
+        line.resize((end == std::string::npos)?0:(end + 1));
+        if (line.empty()){
+            continue;
+        }
+
+        // 6.2. ... an Armor Checksum
+        if ((line[0] == '=') && (line.size() == 5) && carry.empty()){
+            const std::string crc_octets = radix642ascii(line.substr(1));
+            checksum = (static_cast <uint32_t> (static_cast <uint8_t> (crc_octets[0])) << 16) |
+                       (static_cast <uint32_t> (static_cast <uint8_t> (crc_octets[1])) <<  8) |
+                        static_cast <uint32_t> (static_cast <uint8_t> (crc_octets[2]));
+            checksum_found = true;
+            continue;
+        }
+
+        // only decode complete groups
+        carry += line;
+        const std::string::size_type usable = carry.size() & ~static_cast <std::string::size_type> (3);
+        if (!usable){
+            continue;
+        }
+
+        buffer.resize((usable >> 2) * 3);
+        buffer.resize(radix642ascii(carry.data(), usable, reinterpret_cast <uint8_t *> (&buffer[0])));
+        carry.erase(0, usable);
+
+        crc = crc24_update(crc, reinterpret_cast <const uint8_t *> (buffer.data()), buffer.size());
+
+        if (buffer.size()){
+            return true;
+        }
+    }
+
+    if (carry.size()){
+        throw std::runtime_error("Error: Input string length is not a multiple of 4.");
+    }
+
+    return false;
+}
+
+ArmorReader::int_type ArmorReader::underflow(){
+    if (gptr() < egptr()){
+        return traits_type::to_int_type(*gptr());
+    }
+
+    if (!next_line()){
+        return traits_type::eof();
+    }
+
+    setg(&buffer[0], &buffer[0], &buffer[0] + buffer.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+ArmorReader::ArmorReader(std::istream & stream)
+    : std::streambuf(),
+      in(stream),
+      carry(),
+      buffer(),
+      crc(CRC24_INIT),
+      checksum(0),
+      checksum_found(false),
+      done(false)
+{}
+
+bool ArmorReader::finished() const{
+    return done;
+}
+
+bool ArmorReader::has_checksum() const{
+    return checksum_found;
+}
+
+bool ArmorReader::valid() const{
+    return checksum_found && (crc == checksum);
+}
+
+const std::size_t ArmorWriter::OCTETS_PER_LINE;
+
+void ArmorWriter::encode(const bool all){
+    const std::size_t size = pptr() - pbase();
+    const std::size_t full = all?size:(size - (size % OCTETS_PER_LINE));
+    const uint8_t * in = reinterpret_cast <const uint8_t *> (buffer);
+
+    crc = crc24_update(crc, in, full);
+
+    lines.resize(((full + OCTETS_PER_LINE - 1) / OCTETS_PER_LINE) * (MAX_LINE_LENGTH + 1));
+    std::size_t used = 0;
+    for(std::size_t i = 0; i < full; i += OCTETS_PER_LINE){
+        used += ascii2radix64(in + i, std::min(OCTETS_PER_LINE, full - i), &lines[used]);
+        lines[used++] = '\n';
+    }
+    out.write(lines.data(), used);
+
+    // keep the partial line
+    std::copy(buffer + full, buffer + size, buffer);
+    setp(buffer, buffer + sizeof(buffer));
+    pbump(static_cast <int> (size - full));
+}
+
+ArmorWriter::int_type ArmorWriter::overflow(int_type c){
+    if (closed){
+        return traits_type::eof();
+    }
+
+    encode(false);
+
+    if (!traits_type::eq_int_type(c, traits_type::eof())){
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+}
+
+int ArmorWriter::sync(){
+    if (!closed){
+        encode(false);
+    }
+    out.flush();
+    return out?0:-1;
+}
+
+ArmorWriter::ArmorWriter(std::ostream & stream, const std::string & type, const Keys & keys)
+    : std::streambuf(),
+      out(stream),
+      type(type),
+      lines(),
+      crc(CRC24_INIT),
+      closed(false)
+{
+    setp(buffer, buffer + sizeof(buffer));
+
+    out << "-----BEGIN PGP " << type << "-----\n";
+    for(std::pair <std::string, std::string> const & key : keys){
+        out << key.first << ": " << key.second << "\n";
+    }
+    out << "\n";
+}
+
+ArmorWriter::~ArmorWriter(){
+    try{
+        close();
+    }
+    catch (...){}
+}
+
+void ArmorWriter::close(){
+    if (closed){
+        return;
+    }
+
+    encode(true);
+    closed = true;
+
+    const uint8_t checksum[3] = {static_cast <uint8_t> (crc >> 16), static_cast <uint8_t> (crc >> 8), static_cast <uint8_t> (crc)};
+    char encoded[4];
+    ascii2radix64(checksum, sizeof(checksum), encoded);
+    out << "=";
+    out.write(encoded, sizeof(encoded));
+    out << "\n-----END PGP " << type << "-----\n";
+}
+
+}
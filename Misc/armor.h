@@ -0,0 +1,112 @@
+/*
+armor.h
+Streaming ASCII Armor decoding and encoding, as defined by OpenPGP in RFC 4880 sec 6.2
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ARMOR__
+#define __ARMOR__
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CRC-24.h"
+#include "radix64.h"
+
+namespace OpenPGP {
+    // Decodes the Radix-64 body of an armored block one line at a time,
+    // updating the CRC-24 as it goes. The stream must be positioned after
+    // the blank line that ends the Armor Headers. Reading stops at the
+    // Armor Tail, which is consumed from the underlying stream.
+    class ArmorReader : public std::streambuf {
+        private:
+            std::istream & in;
+            std::string carry;      // characters that did not make up a full group
+            std::string buffer;     // decoded octets of the current line
+            uint32_t crc;
+            uint32_t checksum;
+            bool checksum_found;
+            bool done;
+
+            // decode the next line into buffer; returns false at the end of the body
+            bool next_line();
+
+        protected:
+            int_type underflow();
+
+        public:
+            ArmorReader(std::istream & stream);
+
+            // whether the Armor Tail (or the end of the stream) has been reached
+            bool finished() const;
+
+            // whether an armor checksum line was present
+            bool has_checksum() const;
+
+            // whether the checksum matches the decoded data; only meaningful once finished
+            bool valid() const;
+    };
+
+    // Encodes everything written to it as the body of an armored block,
+    // wrapping lines at MAX_LINE_LENGTH and updating the CRC-24 as it goes.
+    // The Armor Header Line and Armor Headers are written on construction;
+    // the checksum and Armor Tail are written by close().
+    class ArmorWriter : public std::streambuf {
+        public:
+            typedef std::vector <std::pair <std::string, std::string> > Keys;
+
+        private:
+            static const std::size_t OCTETS_PER_LINE = (MAX_LINE_LENGTH >> 2) * 3;
+
+            std::ostream & out;
+            std::string type;
+            char buffer[OCTETS_PER_LINE * 64];
+            std::string lines;      // encoded output of one buffer
+            uint32_t crc;
+            bool closed;
+
+            // write out complete lines, or everything if all is set
+            void encode(const bool all);
+
+        protected:
+            int_type overflow(int_type c);
+            int sync();
+
+        public:
+            // type is the text between "BEGIN PGP " and the dashes, e.g. "MESSAGE"
+            ArmorWriter(std::ostream & stream, const std::string & type, const Keys & keys = Keys());
+            ArmorWriter(const ArmorWriter & copy) = delete;
+            ~ArmorWriter();
+
+            // finish the body; nothing may be written afterwards
+            void close();
+
+            ArmorWriter & operator=(const ArmorWriter & copy) = delete;
+    };
+}
+
+#endif
@@ -1,15 +1,108 @@
 #include "cfb.h"
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
 namespace OpenPGP {
 
-std::string OpenPGP_CFB_encrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, std::string prefix){
+namespace {
+
+// decrypt the ciphertext in [begin, end) into out
+// the keystream for the block at offset o is the encryption of in[o - BS, o)
+void CFB_decrypt_range(SymAlg & crypt, const std::size_t BS, const uint8_t * in, uint8_t * out, std::size_t begin, const std::size_t end){
+    while ((begin + BS) <= end){
+        const std::size_t blocks = std::min((end - begin) / BS, CFB_BATCH_BLOCKS);
+        const std::size_t len = blocks * BS;
+
+        crypt.encrypt_blocks(in + begin - BS, out + begin, blocks);
+        for(std::size_t i = begin; i < (begin + len); i++){
+            out[i] ^= in[i];
+        }
+
+        begin += len;
+    }
+
+    // partial last block
+    if (begin < end){
+        uint8_t FRE[CFB_MAX_BLOCK];
+        crypt.encrypt_blocks(in + begin - BS, FRE, 1);
+        for(std::size_t i = begin; i < end; i++){
+            out[i] = in[i] ^ FRE[i - begin];
+        }
+    }
+}
+
+// checks the prefix and sets up out with the prefix and check octets
+// returns the offset of the first octet that still needs to be decrypted
+std::size_t OpenPGP_CFB_decrypt_prefix(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, std::string & out){
     const std::size_t BS = crypt -> blocksize() >> 3;
 
-    if (prefix.size() < (BS + 2)){
+    if ((packet != Packet::SYMMETRICALLY_ENCRYPTED_DATA) &&
+        (packet != Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA)){
+        throw std::runtime_error("Error: Bad Packet Type");
+    }
+
+    if (BS > CFB_MAX_BLOCK){
+        throw std::runtime_error("Error: Block size too large.");
+    }
+
+    if (data.size() < (BS + 2)){
+        throw std::runtime_error("Error: Data too short.");
+    }
+
+    //    1. The feedback register (FR) is set to the IV, which is all zeros.
+    std::string FR(BS, 0);
+
+    //    2. FR is encrypted to produce FRE (FR Encrypted). This is the encryption of an all-zero value.
+    std::string FRE = crypt -> encrypt(FR);
+
+    //    4. FR is loaded with C[1] through C[BS].
+    FR = data.substr(0, BS);
+
+    //    3. FRE is xored with the first BS octets of random data prefixed to the plaintext to produce C[1] through C[BS], the first BS octets of ciphertext.
+    const std::string prefix = xor_strings(FRE, FR);
+
+    //    5. FR is encrypted to produce FRE, the encryption of the first BS octets of ciphertext.
+    FRE = crypt -> encrypt(FR); // encryption of ciphertext
+
+    //    6. The left two octets of FRE get xored with the next two octets of data that were prefixed to the plaintext. This produces C[BS+1] and C[BS+2], the next two octets of ciphertext.
+    if (prefix.substr(BS - 2, 2) != xor_strings(FRE.substr(0, 2), data.substr(BS, 2))){
+        throw std::runtime_error("Error: Bad OpenPGP_CFB check value.");
+    }
+
+    // always returns prefix + 2 octets + cleartext, which is as long as the ciphertext
+    out.assign(data.size(), 0);
+    out.replace(0, BS, prefix);
+
+    // with resynchronization, the blocks start after the 2 check octets
+    // without, the check octets are the start of the second block
+    std::size_t start = BS;
+    if (packet == Packet::SYMMETRICALLY_ENCRYPTED_DATA){
+        out.replace(BS, 2, prefix.substr(BS - 2, 2));
+        start += 2;
+    }
+
+    return start;
+}
+
+}
+
+void OpenPGP_CFB_encrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const uint8_t * in, uint8_t * out, const std::size_t size){
+    const std::size_t BS = crypt -> blocksize() >> 3;
+
+    if (BS > CFB_MAX_BLOCK){
+        throw std::runtime_error("Error: Block size too large.");
+    }
+
+    if (size < (BS + 2)){
         throw std::runtime_error("Error: Given prefix too short.");
     }
-    else if (prefix.size() > (BS + 2)){
-        prefix = prefix.substr(0, BS + 2);    // reduce prefix
+
+    if ((packet != Packet::SYMMETRICALLY_ENCRYPTED_DATA) &&
+        (packet != Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA)){
+        throw std::runtime_error("Error: Bad Packet Type");
     }
 
     // 13.9. OpenPGP CFB Mode
@@ -40,102 +133,134 @@ std::string OpenPGP_CFB_encrypt(const SymAlg::Ptr & crypt, const uint8_t packet,
     //    correct key.
     //
     //    Step by step, here is the procedure:
+    //
+    // The feedback register is always the previous BS octets of ciphertext,
+    // which are already in out, so only its encryption needs to be kept.
 
     //    1. The feedback register (FR) is set to the IV, which is all zeros.
-    std::string FR(BS, 0);
-
     //    2. FR is encrypted to produce FRE (FR Encrypted). This is the encryption of an all-zero value.
-    std::string FRE = crypt -> encrypt(FR);
+    uint8_t FRE[CFB_MAX_BLOCK] = {0};
+    crypt -> encrypt_blocks(FRE, 1);
 
     //    3. FRE is xored with the first BS octets of random data prefixed to the plaintext to produce C[1] through C[BS], the first BS octets of ciphertext.
-    FRE = xor_strings(FRE, prefix);
-    std::string C = FRE;
-
-    //    4. FR is loaded with C[1] through C[BS].
-    FR = C;
-
-    //    5. FR is encrypted to produce FRE, the encryption of the first BS octets of ciphertext.
-    FRE = crypt -> encrypt(FR);
+    for(std::size_t i = 0; i < BS; i++){
+        out[i] = in[i] ^ FRE[i];
+    }
 
+    std::size_t x = BS;
     if (packet == Packet::SYMMETRICALLY_ENCRYPTED_DATA){                    // resynchronization
+        //    4. FR is loaded with C[1] through C[BS].
+        //    5. FR is encrypted to produce FRE, the encryption of the first BS octets of ciphertext.
+        crypt -> encrypt_blocks(out, FRE, 1);
+
         //    6. The left two octets of FRE get xored with the next two octets of data that were prefixed to the plaintext. This produces C[BS+1] and C[BS+2], the next two octets of ciphertext.
-        C += xor_strings(FRE.substr(0, 2), prefix.substr(BS - 2, 2));
+        out[BS]     = in[BS]     ^ FRE[0];
+        out[BS + 1] = in[BS + 1] ^ FRE[1];
 
         //    7. (The resynchronization step) FR is loaded with C[3] through C[BS+2].
-        FR = C.substr(2, BS);
+        x += 2;
+    }
+    // 5.13. Sym. Encrypted Integrity Protected Data Packet (Tag 18)
+    //
+    //    Unlike the Symmetrically Encrypted Data Packet, no
+    //    special CFB resynchronization is done after encrypting this prefix
+    //    data.
+    //
+    // The 2 repeated octets are the start of the second block.
 
+    while (x < size){
         //    8. FR is encrypted to produce FRE.
-        FRE = crypt -> encrypt(FR);
+        crypt -> encrypt_blocks(out + x - BS, FRE, 1);
 
-        //    9. FRE is xored with the first BS octets of the given plaintext, now that we have finished encrypting the BS+2 octets of prefixed data. This produces C[BS+3] through C[BS+(BS+2)], the next BS octets of ciphertext.
-        C += xor_strings(FRE, data.substr(0, BS));
-    }
-    else if (packet == Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA){     // no resynchronization
-        // 5.13. Sym. Encrypted Integrity Protected Data Packet (Tag 18)
-        //
-        //    Unlike the Symmetrically Encrypted Data Packet, no
-        //    special CFB resynchronization is done after encrypting this prefix
-        //    data.
+        //    9. FRE is xored with the next BS octets of plaintext, to produce the next BS octets of ciphertext. These are loaded into FR, and the process is repeated until the plaintext is used up.
+        const std::size_t end = std::min(x + BS, size);
+        for(std::size_t i = x; i < end; i++){
+            out[i] = in[i] ^ FRE[i - x];
+        }
 
-        // Second block of ciphertext is the 2 repeated octets + the first BS - 2 octets of the plaintext
-        C += xor_strings(FRE, prefix.substr(BS - 2, 2) + data.substr(0, BS - 2));
-    }
-    else{
-        throw std::runtime_error("Error: Bad Packet Type");
+        x += BS;
     }
+}
 
-    std::string::size_type x = BS - ((packet == Packet::SYMMETRICALLY_ENCRYPTED_DATA)?0:2);
-    while (x < data.size()){
-        //    10. FR is loaded with C[BS+3] to C[BS + (BS+2)] (which is C11-C18 for an 8-octet block).
-        FR = C.substr(x + 2, BS);
-
-        //    11. FR is encrypted to produce FRE.
-        FRE = crypt -> encrypt(FR);
+void OpenPGP_CFB_encrypt_in_place(const SymAlg::Ptr & crypt, const uint8_t packet, std::string & data){
+    uint8_t * buf = reinterpret_cast <uint8_t *> (&data[0]);
+    OpenPGP_CFB_encrypt(crypt, packet, buf, buf, data.size());
+}
 
-        //    12. FRE is xored with the next BS octets of plaintext, to produce the next BS octets of ciphertext. These are loaded into FR, and the process is repeated until the plaintext is used up.
-        C += xor_strings(FRE, data.substr(x, BS));
+std::string OpenPGP_CFB_encrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, std::string prefix){
+    const std::size_t BS = crypt -> blocksize() >> 3;
 
-        x += BS;
+    if (prefix.size() < (BS + 2)){
+        throw std::runtime_error("Error: Given prefix too short.");
     }
 
+    // the last 2 octets of the prefix always repeat octets BS - 1 and BS
+    std::string C;
+    C.reserve(BS + 2 + data.size());
+    C.append(prefix, 0, BS);
+    C.append(prefix, BS - 2, 2);
+    C += data;
+
+    OpenPGP_CFB_encrypt_in_place(crypt, packet, C);
     return C;
 }
 
-std::string OpenPGP_CFB_decrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data){
+std::string OpenPGP_CFB_decrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, unsigned int threads){
+    std::string out;
+    const std::size_t start = OpenPGP_CFB_decrypt_prefix(crypt, packet, data, out);
     const std::size_t BS = crypt -> blocksize() >> 3;
 
-    //    1. The feedback register (FR) is set to the IV, which is all zeros.
-    std::string FR(BS, 0);
+    const uint8_t * in = reinterpret_cast <const uint8_t *> (data.data());
+    uint8_t * dst = reinterpret_cast <uint8_t *> (&out[0]);
 
-    //    2. FR is encrypted to produce FRE (FR Encrypted). This is the encryption of an all-zero value.
-    std::string FRE = crypt -> encrypt(FR);
+    if (!threads){
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
 
-    //    4. FR is loaded with C[1] through C[BS].
-    FR = data.substr(0, BS);
+    const std::size_t blocks = (data.size() - start + BS - 1) / BS;
+    if ((threads < 2) || ((data.size() - start) < CFB_PARALLEL_THRESHOLD)){
+        CFB_decrypt_range(*crypt, BS, in, dst, start, data.size());
+        return out;
+    }
 
-    //    3. FRE is xored with the first BS octets of random data prefixed to the plaintext to produce C[1] through C[BS], the first BS octets of ciphertext.
-    std::string prefix = xor_strings(FRE, FR);
+    // give each thread a contiguous run of blocks
+    std::vector <std::thread> workers;
+    const std::size_t per_thread = (blocks + threads - 1) / threads;
+    std::size_t begin = start;
+    for(unsigned int t = 1; t < threads; t++){
+        const std::size_t end = std::min(begin + per_thread * BS, data.size());
+        workers.emplace_back(CFB_decrypt_range, std::ref(*crypt), BS, in, dst, begin, end);
+        begin = end;
+    }
 
-    //    5. FR is encrypted to produce FRE, the encryption of the first BS octets of ciphertext.
-    FRE = crypt -> encrypt(FR); // encryption of ciphertext
+    // last run is done on this thread
+    CFB_decrypt_range(*crypt, BS, in, dst, begin, data.size());
 
-    //    6. The left two octets of FRE get xored with the next two octets of data that were prefixed to the plaintext. This produces C[BS+1] and C[BS+2], the next two octets of ciphertext.
-    if (prefix.substr(BS - 2, 2) != xor_strings(FRE.substr(0, 2), data.substr(BS, 2))){
-        throw std::runtime_error("Error: Bad OpenPGP_CFB check value.");
+    for(std::thread & worker : workers){
+        worker.join();
     }
 
-    std::string P = "";
-    std::string::size_type x = (packet == Packet::SYMMETRICALLY_ENCRYPTED_DATA)?2:0;
-    while ((x + BS) < data.size()){
-        std::string substr = data.substr(x, BS);
-        P += xor_strings(FRE, substr);
-        FRE = crypt -> encrypt(substr);
-        x += BS;
+    return out;
+}
+
+std::string OpenPGP_CFB_decrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, const CFB_Sink & sink){
+    std::string out;
+    std::size_t begin = OpenPGP_CFB_decrypt_prefix(crypt, packet, data, out);
+    const std::size_t BS = crypt -> blocksize() >> 3;
+
+    const uint8_t * in = reinterpret_cast <const uint8_t *> (data.data());
+    uint8_t * dst = reinterpret_cast <uint8_t *> (&out[0]);
+
+    sink(dst, begin);
+
+    while (begin < data.size()){
+        const std::size_t end = std::min(begin + CFB_BATCH_BLOCKS * BS, data.size());
+        CFB_decrypt_range(*crypt, BS, in, dst, begin, end);
+        sink(dst + begin, end - begin);
+        begin = end;
     }
-    P += xor_strings(FRE, data.substr(x, BS));
-    P = P.substr(BS, P.size() - BS);
 
-    return prefix + ((packet == 9)?prefix.substr(BS - 2, 2):std::string("")) + P;   // only add prefix 2 octets when resyncing - already shows up without resync
+    return out;
 }
 
 std::string use_OpenPGP_CFB_encrypt(const uint8_t sym_alg, const uint8_t packet, const std::string & data, const std::string & key, const std::string & prefix){
@@ -147,36 +272,26 @@ std::string use_OpenPGP_CFB_encrypt(const uint8_t sym_alg, const uint8_t packet,
     return OpenPGP_CFB_encrypt(alg, packet, data, prefix);
 }
 
-std::string use_OpenPGP_CFB_decrypt(const uint8_t sym_alg, const uint8_t packet, const std::string & data, const std::string & key){
+std::string use_OpenPGP_CFB_decrypt(const uint8_t sym_alg, const uint8_t packet, const std::string & data, const std::string & key, const unsigned int threads){
     if (!sym_alg){
         return data;
     }
 
     const SymAlg::Ptr alg = Sym::setup(sym_alg, key);
-    return OpenPGP_CFB_decrypt(alg, packet, data);
+    return OpenPGP_CFB_decrypt(alg, packet, data, threads);
 }
 
 std::string normal_CFB_encrypt(const SymAlg::Ptr & crypt, const std::string & data, std::string IV){
-    std::string out = "";
-    const std::size_t BS = crypt -> blocksize() >> 3;
-    std::string::size_type x = 0;
-    while (out.size() < data.size()){
-        IV = xor_strings(crypt -> encrypt(IV), data.substr(x, BS));
-        out += IV;
-        x += BS;
-    }
+    CFBEncryptor cfb(crypt, IV);
+    const std::string out = cfb.update(data);
+    cfb.finish();
     return out;
 }
 
 std::string normal_CFB_decrypt(const SymAlg::Ptr & crypt, const std::string & data, std::string IV){
-    std::string out = "";
-    const std::size_t BS = crypt -> blocksize() >> 3;
-    std::string::size_type x = 0;
-    while (x < data.size()){
-        out += xor_strings(crypt -> encrypt(IV), data.substr(x, BS));
-        IV = data.substr(x, BS);
-        x += BS;
-    }
+    CFBDecryptor cfb(crypt, IV);
+    const std::string out = cfb.update(data);
+    cfb.finish();
     return out;
 }
 
@@ -198,4 +313,141 @@ std::string use_normal_CFB_decrypt(const uint8_t sym_alg, const std::string & da
     return normal_CFB_decrypt(alg, data, IV);
 }
 
-}
\ No newline at end of file
+CFB::CFB(const SymAlg::Ptr & alg, const std::string & IV)
+    : crypt(alg),
+      BS(alg -> blocksize() >> 3),
+      openpgp(false),
+      resync(false),
+      finished(false),
+      count(0),
+      pos(0),
+      FR(), FRE(), C(), check()
+{
+    if (BS > CFB_MAX_BLOCK){
+        throw std::runtime_error("Error: Block size too large.");
+    }
+
+    if (IV.size() != BS){
+        throw std::runtime_error("Error: IV must be exactly one block long.");
+    }
+
+    std::copy(IV.begin(), IV.end(), FR);
+    crypt -> encrypt_blocks(FR, FRE, 1);
+}
+
+CFB::CFB(const SymAlg::Ptr & alg, const uint8_t packet)
+    : CFB(alg, std::string(alg -> blocksize() >> 3, 0))
+{
+    if ((packet != Packet::SYMMETRICALLY_ENCRYPTED_DATA) &&
+        (packet != Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA)){
+        throw std::runtime_error("Error: Bad Packet Type");
+    }
+
+    openpgp = true;
+    resync = (packet == Packet::SYMMETRICALLY_ENCRYPTED_DATA);
+}
+
+CFB::~CFB(){}
+
+void CFB::process(const uint8_t * in, uint8_t * out, const std::size_t len, const bool decrypt){
+    if (finished){
+        throw std::runtime_error("Error: CFB stream has already been finished.");
+    }
+
+    bool bad = false;
+    std::size_t i = 0;
+    while (i < len){
+        // whole blocks once the prefix has been handled
+        if ((pos == 0) && ((len - i) >= BS) && (!openpgp || (count >= (BS + 2)))){
+            for(std::size_t j = 0; j < BS; j++){
+                const uint8_t c = in[i + j];
+                out[i + j] = c ^ FRE[j];
+                FR[j] = decrypt?c:out[i + j];
+            }
+            crypt -> encrypt_blocks(FR, FRE, 1);
+            i += BS;
+            count += BS;
+            continue;
+        }
+
+        const uint8_t c = in[i];
+        out[i] = c ^ FRE[pos];
+        C[pos++] = decrypt?c:out[i];
+
+        if (openpgp && (count < (BS + 2))){
+            const uint8_t plain = decrypt?out[i]:c;
+            if (count >= BS){
+                bad |= (check[count - BS] != plain);
+            }
+            else if (count >= (BS - 2)){
+                check[count + 2 - BS] = plain;
+            }
+        }
+
+        count++;
+        i++;
+
+        if (resync && (count == (BS + 2))){
+            // FR is loaded with C[3] through C[BS+2]
+            std::copy(FR + 2, FR + BS, FR);
+            std::copy(C, C + 2, FR + BS - 2);
+            crypt -> encrypt_blocks(FR, FRE, 1);
+            pos = 0;
+        }
+        else if (pos == BS){
+            std::copy(C, C + BS, FR);
+            crypt -> encrypt_blocks(FR, FRE, 1);
+            pos = 0;
+        }
+    }
+
+    if (bad){
+        throw std::runtime_error("Error: Bad OpenPGP_CFB check value.");
+    }
+}
+
+void CFB::finish(){
+    if (openpgp && (count < (BS + 2))){
+        throw std::runtime_error("Error: Given prefix too short.");
+    }
+
+    finished = true;
+}
+
+CFBEncryptor::CFBEncryptor(const SymAlg::Ptr & alg, const std::string & IV)
+    : CFB(alg, IV)
+{}
+
+CFBEncryptor::CFBEncryptor(const SymAlg::Ptr & alg, const uint8_t packet)
+    : CFB(alg, packet)
+{}
+
+void CFBEncryptor::update(const uint8_t * in, uint8_t * out, const std::size_t len){
+    process(in, out, len, false);
+}
+
+std::string CFBEncryptor::update(const std::string & data){
+    std::string out(data.size(), 0);
+    update(reinterpret_cast <const uint8_t *> (data.data()), reinterpret_cast <uint8_t *> (&out[0]), data.size());
+    return out;
+}
+
+CFBDecryptor::CFBDecryptor(const SymAlg::Ptr & alg, const std::string & IV)
+    : CFB(alg, IV)
+{}
+
+CFBDecryptor::CFBDecryptor(const SymAlg::Ptr & alg, const uint8_t packet)
+    : CFB(alg, packet)
+{}
+
+void CFBDecryptor::update(const uint8_t * in, uint8_t * out, const std::size_t len){
+    process(in, out, len, true);
+}
+
+std::string CFBDecryptor::update(const std::string & data){
+    std::string out(data.size(), 0);
+    update(reinterpret_cast <const uint8_t *> (data.data()), reinterpret_cast <uint8_t *> (&out[0]), data.size());
+    return out;
+}
+
+}
@@ -26,19 +26,43 @@ THE SOFTWARE.
 #ifndef __OPENPGP_CFB__
 #define __OPENPGP_CFB__
 
+#include <cstddef>
+#include <functional>
 #include <stdexcept>
 
 #include "../Encryptions/Encryptions.h"
 #include "../Packets/Packet.h"
 
 namespace OpenPGP {
+    // largest supported block size in octets
+    const std::size_t CFB_MAX_BLOCK = 16;
+
+    // number of blocks passed to the cipher at a time while decrypting
+    const std::size_t CFB_BATCH_BLOCKS = 64;
+
+    // bodies shorter than this are always decrypted on the calling thread
+    const std::size_t CFB_PARALLEL_THRESHOLD = 1 << 20;
+
     // OpenPGP CFB as described in RFC 4880 section 13.9
+    // in holds the BS + 2 octet prefix followed by the plaintext, and out receives
+    // the same number of octets of ciphertext. in and out may point to the same buffer.
+    void OpenPGP_CFB_encrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const uint8_t * in, uint8_t * out, const std::size_t size);
+    // encrypts prefix + plaintext held in data without allocating
+    void OpenPGP_CFB_encrypt_in_place(const SymAlg::Ptr & crypt, const uint8_t packet, std::string & data);
     std::string OpenPGP_CFB_encrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, std::string prefix = "");
-    std::string OpenPGP_CFB_decrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data);
+    // Each keystream block only depends on the previous ciphertext block,
+    // so decryption runs in batches and can be split across threads.
+    // threads = 0 uses all available hardware threads.
+    std::string OpenPGP_CFB_decrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, unsigned int threads = 1);
+    // Same output as above, decrypted on this thread one batch at a time.
+    // Each batch of plaintext, starting with the prefix, is passed to sink
+    // right after it is produced so it can be consumed while still in cache.
+    typedef std::function <void(const uint8_t *, const std::size_t)> CFB_Sink;
+    std::string OpenPGP_CFB_decrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data, const CFB_Sink & sink);
     // Helper functions
     std::string use_OpenPGP_CFB_encrypt(const uint8_t sym_alg, const uint8_t packet, const std::string & data, const std::string & key, const std::string & prefix = "");
     // always returns prefix + 2 octets + cleartext
-    std::string use_OpenPGP_CFB_decrypt(const uint8_t sym_alg, const uint8_t packet, const std::string & data, const std::string & key);
+    std::string use_OpenPGP_CFB_decrypt(const uint8_t sym_alg, const uint8_t packet, const std::string & data, const std::string & key, const unsigned int threads = 1);
 
     // Standard CFB mode
     std::string normal_CFB_encrypt(const SymAlg::Ptr & crypt, const std::string & data, std::string IV);
@@ -46,6 +70,61 @@ namespace OpenPGP {
     // Helper functions
     std::string use_normal_CFB_encrypt(const uint8_t sym_alg, const std::string & data, const std::string & key, const std::string & IV);
     std::string use_normal_CFB_decrypt(const uint8_t sym_alg, const std::string & data, const std::string & key, const std::string & IV);
+
+    // Streaming CFB
+    //
+    // Data can be given in chunks of any size with update(). The feedback
+    // register and position in the current block are kept between calls.
+    // In OpenPGP mode the first BS + 2 octets of the stream are the prefix,
+    // and its check octets are verified as soon as they have been seen.
+    class CFB{
+        protected:
+            SymAlg::Ptr crypt;
+            std::size_t BS;
+            bool openpgp;                   // zero IV with BS + 2 octet prefix
+            bool resync;                    // Tag 9 resynchronization after the prefix
+            bool finished;
+            std::size_t count;              // octets processed so far
+            std::size_t pos;                // octets of FRE already used
+            uint8_t FR[CFB_MAX_BLOCK];      // feedback register
+            uint8_t FRE[CFB_MAX_BLOCK];     // encryption of FR
+            uint8_t C[CFB_MAX_BLOCK];       // ciphertext of the current block
+            uint8_t check[2];               // prefix octets BS - 1 and BS
+
+            // normal CFB
+            CFB(const SymAlg::Ptr & alg, const std::string & IV);
+
+            // OpenPGP CFB for a Tag 9 or Tag 18 body
+            CFB(const SymAlg::Ptr & alg, const uint8_t packet);
+
+            void process(const uint8_t * in, uint8_t * out, const std::size_t len, const bool decrypt);
+
+        public:
+            virtual ~CFB();
+
+            // check that a complete stream was given; update() may not be called afterwards
+            void finish();
+    };
+
+    class CFBEncryptor : public CFB{
+        public:
+            CFBEncryptor(const SymAlg::Ptr & alg, const std::string & IV);
+            CFBEncryptor(const SymAlg::Ptr & alg, const uint8_t packet);
+
+            // in and out may point to the same buffer
+            void update(const uint8_t * in, uint8_t * out, const std::size_t len);
+            std::string update(const std::string & data);
+    };
+
+    class CFBDecryptor : public CFB{
+        public:
+            CFBDecryptor(const SymAlg::Ptr & alg, const std::string & IV);
+            CFBDecryptor(const SymAlg::Ptr & alg, const uint8_t packet);
+
+            // in and out may point to the same buffer
+            void update(const uint8_t * in, uint8_t * out, const std::size_t len);
+            std::string update(const std::string & data);
+    };
 }
 
 #endif
@@ -1,4 +1,5 @@
-MISC_OBJECTS=cfb.o      \
+MISC_OBJECTS=armor.o    \
+             cfb.o      \
              CRC-24.o   \
              mpi.o      \
              pgptime.o  \
@@ -1,78 +1,324 @@
 #include "radix64.h"
 
+#include "../common/CPU.h"
+
+#ifdef CPU_X86
+#define RADIX64_SIMD
+#endif
+
+#ifdef RADIX64_SIMD
+#include <immintrin.h>
+
+#define RADIX64_SSSE3 __attribute__((target("ssse3")))
+#define RADIX64_AVX2  __attribute__((target("avx2")))
+#endif
+
 namespace OpenPGP {
 
-std::string ascii2radix64(std::string str, const unsigned char char62, const unsigned char char63){
-    std::string out = "", bin = "", pad = "";
-    while (str.size() % 3){
-        str += zero;
-        pad += "=";
+namespace {
+
+const uint8_t INVALID = 0xff;
+
+// alphabet and its inverse for one choice of char62 and char63
+struct Tables{
+    char encode[64];
+    uint8_t decode[256];
+
+    Tables() {}
+    Tables(const unsigned char char62, const unsigned char char63){
+        const char * alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+        for(uint8_t i = 0; i < 62; i++){
+            encode[i] = alphabet[i];
+        }
+        encode[62] = char62;
+        encode[63] = char63;
+
+        for(uint8_t & d : decode){
+            d = INVALID;
+        }
+        for(uint8_t i = 0; i < 64; i++){
+            decode[static_cast <unsigned char> (encode[i])] = i;
+        }
+    }
+};
+
+// the standard alphabet is only built once
+const Tables & tables(const unsigned char char62, const unsigned char char63, Tables & custom){
+    static const Tables standard('+', '/');
+    if ((char62 == '+') && (char63 == '/')){
+        return standard;
+    }
+    custom = Tables(char62, char63);
+    return custom;
+}
+
+void invalid(const char c){
+    throw std::runtime_error("Error: Invalid Radix64 character found: " + std::string(1, c));
+}
+
+#ifdef RADIX64_SIMD
+
+// Encoding (W. Mula, D. Lemire): spread 12 octets into 16 6-bit indices,
+// then add a per-range offset selected with pshufb. The offsets for 62 and 63
+// come from the chosen alphabet, so char62 and char63 cost nothing extra.
+//
+// Decoding: map each character to its value with range compares, reject the
+// whole block if anything is outside the alphabet, and pack 4 values into 3 octets.
+
+// offsets added to each 6-bit index, selected by the range it falls in
+RADIX64_SSSE3
+__m128i encode_offsets(const Tables & t){
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, '0' - 52, '0' - 52, static_cast <char> (t.encode[62] - 62), static_cast <char> (t.encode[63] - 63), 'A', 0, 0);
+}
+
+// 12 octets -> 16 characters at a time; reads 16 octets, so in needs 4 octets of slack
+// returns the number of octets consumed
+RADIX64_SSSE3
+std::size_t encode_ssse3(const uint8_t * in, const std::size_t len, char * out, const Tables & t){
+    const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i offsets = encode_offsets(t);
+
+    std::size_t i = 0;
+    for(; (i + 16) <= len; i += 12, out += 16){
+        const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast <const __m128i *> (in + i)), shuffle);
+        const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t0, t1);
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        _mm_storeu_si128(reinterpret_cast <__m128i *> (out), _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices));
+    }
+    return i;
+}
+
+// 24 octets -> 32 characters at a time; reads 28 octets
+RADIX64_AVX2
+std::size_t encode_avx2(const uint8_t * in, const std::size_t len, char * out, const Tables & t){
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_broadcastsi128_si256(encode_offsets(t));
+
+    std::size_t i = 0;
+    for(; (i + 28) <= len; i += 24, out += 32){
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast <const __m128i *> (in + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast <const __m128i *> (in + i + 12));
+        const __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), shuffle);
+        const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t0, t1);
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+        _mm256_storeu_si256(reinterpret_cast <__m256i *> (out), _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices));
+    }
+    return i;
+}
+
+// value of each character in [lo, hi]
+RADIX64_SSSE3
+__m128i range_128(const __m128i c, const char lo, const char hi, const char add, __m128i & valid){
+    const __m128i in = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8(hi + 1)));
+    valid = _mm_or_si128(valid, in);
+    return _mm_and_si128(in, _mm_add_epi8(c, _mm_set1_epi8(add)));
+}
+
+// 16 characters -> 12 octets at a time; writes 16 octets, so out needs 4 octets of slack
+// returns the number of characters consumed; stops at the first block with anything
+// outside the alphabet
+RADIX64_SSSE3
+std::size_t decode_ssse3(const char * in, const std::size_t len, uint8_t * out, const std::size_t out_room, const Tables & t){
+    const __m128i c62 = _mm_set1_epi8(t.encode[62]);
+    const __m128i c63 = _mm_set1_epi8(t.encode[63]);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    std::size_t i = 0;
+    for(; ((i + 16) <= len) && ((((i >> 2) * 3) + 16) <= out_room); i += 16, out += 12){
+        const __m128i c = _mm_loadu_si128(reinterpret_cast <const __m128i *> (in + i));
+        __m128i valid = _mm_setzero_si128();
+        __m128i v = range_128(c, 'A', 'Z', -'A', valid);
+        v = _mm_or_si128(v, range_128(c, 'a', 'z', 26 - 'a', valid));
+        v = _mm_or_si128(v, range_128(c, '0', '9', 52 - '0', valid));
+        const __m128i is62 = _mm_cmpeq_epi8(c, c62);
+        const __m128i is63 = _mm_cmpeq_epi8(c, c63);
+        valid = _mm_or_si128(valid, _mm_or_si128(is62, is63));
+        if (_mm_movemask_epi8(valid) != 0xffff){
+            break;
+        }
+        v = _mm_or_si128(v, _mm_and_si128(is62, _mm_set1_epi8(62)));
+        v = _mm_or_si128(v, _mm_and_si128(is63, _mm_set1_epi8(63)));
+
+        const __m128i ab = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+        const __m128i abcd = _mm_madd_epi16(ab, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast <__m128i *> (out), _mm_shuffle_epi8(abcd, pack));
     }
+    return i;
+}
+
+RADIX64_AVX2
+__m256i range_256(const __m256i c, const char lo, const char hi, const char add, __m256i & valid){
+    const __m256i in = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(lo - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), c));
+    valid = _mm256_or_si256(valid, in);
+    return _mm256_and_si256(in, _mm256_add_epi8(c, _mm256_set1_epi8(add)));
+}
+
+// 32 characters -> 24 octets at a time; writes 28 octets
+RADIX64_AVX2
+std::size_t decode_avx2(const char * in, const std::size_t len, uint8_t * out, const std::size_t out_room, const Tables & t){
+    const __m256i c62 = _mm256_set1_epi8(t.encode[62]);
+    const __m256i c63 = _mm256_set1_epi8(t.encode[63]);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
 
-    for(char const c : str){
-        bin += makebin(c, 8);
+    std::size_t i = 0;
+    for(; ((i + 32) <= len) && ((((i >> 2) * 3) + 28) <= out_room); i += 32, out += 24){
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast <const __m256i *> (in + i));
+        __m256i valid = _mm256_setzero_si256();
+        __m256i v = range_256(c, 'A', 'Z', -'A', valid);
+        v = _mm256_or_si256(v, range_256(c, 'a', 'z', 26 - 'a', valid));
+        v = _mm256_or_si256(v, range_256(c, '0', '9', 52 - '0', valid));
+        const __m256i is62 = _mm256_cmpeq_epi8(c, c62);
+        const __m256i is63 = _mm256_cmpeq_epi8(c, c63);
+        valid = _mm256_or_si256(valid, _mm256_or_si256(is62, is63));
+        if (_mm256_movemask_epi8(valid) != -1){
+            break;
+        }
+        v = _mm256_or_si256(v, _mm256_and_si256(is62, _mm256_set1_epi8(62)));
+        v = _mm256_or_si256(v, _mm256_and_si256(is63, _mm256_set1_epi8(63)));
+
+        const __m256i ab = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        const __m256i abcd = _mm256_shuffle_epi8(_mm256_madd_epi16(ab, _mm256_set1_epi32(0x00011000)), pack);
+        _mm_storeu_si128(reinterpret_cast <__m128i *> (out), _mm256_castsi256_si128(abcd));
+        _mm_storeu_si128(reinterpret_cast <__m128i *> (out + 12), _mm256_extracti128_si256(abcd, 1));
     }
+    return i;
+}
+
+#endif
 
-    std::string::size_type x = 0;
-    while (x < bin.size()){
-        out += ("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789" + std::string(1, char62) + std::string(1, char63))[toint(bin.substr(x, 6), 2)];
-        x += 6;
+}
+
+std::size_t ascii2radix64(const uint8_t * in, const std::size_t len, char * out, const unsigned char char62, const unsigned char char63){
+    Tables custom;
+    const Tables & t = tables(char62, char63, custom);
+    char * const start = out;
+
+    std::size_t i = 0;
+    #ifdef RADIX64_SIMD
+    if (CPU::avx2()){
+        const std::size_t done = encode_avx2(in, len, out, t);
+        out += (done / 3) << 2;
+        i = done;
+    }
+    if (CPU::ssse3()){
+        const std::size_t done = encode_ssse3(in + i, len - i, out, t);
+        out += (done / 3) << 2;
+        i += done;
     }
+    #endif
 
-    if (pad.size() == 2){                       // string length % 3 == 1
-        out = out.substr(0, out.size() - 2);
+    for(; (i + 3) <= len; i += 3){
+        const uint32_t v = (static_cast <uint32_t> (in[i]) << 16) | (static_cast <uint32_t> (in[i + 1]) << 8) | in[i + 2];
+        *out++ = t.encode[(v >> 18) & 63];
+        *out++ = t.encode[(v >> 12) & 63];
+        *out++ = t.encode[(v >>  6) & 63];
+        *out++ = t.encode[ v        & 63];
     }
 
-    if (pad.size() == 1){                       // string length % 3 == 2
-        out = out.substr(0, out.size() - 1);
+    // string length % 3 == 1 or 2
+    if (i < len){
+        const uint32_t v = (static_cast <uint32_t> (in[i]) << 16) | (((i + 1) < len)?(static_cast <uint32_t> (in[i + 1]) << 8):0);
+        *out++ = t.encode[(v >> 18) & 63];
+        *out++ = t.encode[(v >> 12) & 63];
+        *out++ = ((i + 1) < len)?t.encode[(v >> 6) & 63]:'=';
+        *out++ = '=';
     }
 
-    return out + pad;
+    return out - start;
 }
 
-std::string radix642ascii(std::string str, const unsigned char char62, const unsigned char char63){
-    if (str.size() & 3){
+std::string ascii2radix64(const std::string & str, const unsigned char char62, const unsigned char char63){
+    std::string out(((str.size() + 2) / 3) << 2, 0);
+    ascii2radix64(reinterpret_cast <const uint8_t *> (str.data()), str.size(), &out[0], char62, char63);
+    return out;
+}
+
+std::size_t radix642ascii(const char * in, std::size_t len, uint8_t * out, const unsigned char char62, const unsigned char char63){
+    if (len & 3){
         throw std::runtime_error("Error: Input string length is not a multiple of 4.");
     }
 
-    std::string bin = "";
+    Tables custom;
+    const Tables & t = tables(char62, char63, custom);
+    uint8_t * const start = out;
 
     // count padding
     uint8_t unpad = 0;
-    while (str[str.size() - 1] == '='){
+    while (len && (unpad < 2) && (in[len - 1] == '=')){
         unpad++;
-        str = str.substr(0, str.size() - 1);
+        len--;
     }
 
-    for(unsigned char c : str){
-        if (('A' <= c) && (c <= 'Z')){
-            bin += makebin(c - 'A', 6);
-        }
-        else if (('a' <= c) && (c <= 'z')){
-            bin += makebin(c - 'G', 6);
-        }
-        else if (('0' <= c) && (c <= '9')){
-            bin += makebin(c + 4, 6);
-        }
-        else if (c == char62){
-            bin += "111110";
+    // room in out for the complete groups
+    const std::size_t room = (len >> 2) * 3;
+
+    std::size_t i = 0;
+    #ifdef RADIX64_SIMD
+    if (CPU::avx2()){
+        const std::size_t done = decode_avx2(in, len, out, room, t);
+        out += (done >> 2) * 3;
+        i = done;
+    }
+    if (CPU::ssse3()){
+        const std::size_t done = decode_ssse3(in + i, len - i, out, room - ((i >> 2) * 3), t);
+        out += (done >> 2) * 3;
+        i += done;
+    }
+    #endif
+
+    for(; (i + 4) <= len; i += 4){
+        const uint8_t a = t.decode[static_cast <unsigned char> (in[i])];
+        const uint8_t b = t.decode[static_cast <unsigned char> (in[i + 1])];
+        const uint8_t c = t.decode[static_cast <unsigned char> (in[i + 2])];
+        const uint8_t d = t.decode[static_cast <unsigned char> (in[i + 3])];
+        if ((a | b | c | d) == INVALID){
+            for(uint8_t x = 0; x < 4; x++){
+                if (t.decode[static_cast <unsigned char> (in[i + x])] == INVALID){
+                    invalid(in[i + x]);
+                }
+            }
         }
-        else if (c == char63){
-            bin += "111111";
+        const uint32_t v = (static_cast <uint32_t> (a) << 18) | (static_cast <uint32_t> (b) << 12) | (static_cast <uint32_t> (c) << 6) | d;
+        *out++ = v >> 16;
+        *out++ = v >> 8;
+        *out++ = v;
+    }
+
+    // last group with padding removed
+    if (i < len){
+        uint32_t v = 0;
+        for(std::size_t x = 0; x < 4; x++){
+            uint8_t d = 0;
+            if ((i + x) < len){
+                d = t.decode[static_cast <unsigned char> (in[i + x])];
+                if (d == INVALID){
+                    invalid(in[i + x]);
+                }
+            }
+            v = (v << 6) | d;
         }
-        else{
-            throw std::runtime_error("Error: Invalid Radix64 character found: " + std::string(1, c));
+        *out++ = v >> 16;
+        if (unpad == 1){
+            *out++ = v >> 8;
         }
     }
 
-    bin += std::string(unpad * 6, '0');
-
-    str = "";
-    for(unsigned int x = 0; x < bin.size(); x += 8){
-        str += std::string(1, static_cast <unsigned char> (toint(bin.substr(x, 8), 2)));
-    }
+    return out - start;
+}
 
-    return str.substr(0, str.size() - unpad);   // remove padding when returning
+std::string radix642ascii(const std::string & str, const unsigned char char62, const unsigned char char63){
+    std::string out((str.size() >> 2) * 3, 0);
+    out.resize(radix642ascii(str.data(), str.size(), reinterpret_cast <uint8_t *> (&out[0]), char62, char63));
+    return out;
 }
 
-}
\ No newline at end of file
+}
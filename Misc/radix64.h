@@ -26,6 +26,8 @@ THE SOFTWARE.
 #ifndef __RADIX64__
 #define __RADIX64__
 
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
@@ -94,7 +96,11 @@ namespace OpenPGP {
     //       pad characters (=) are added to the output.
     const unsigned int MAX_LINE_LENGTH = 64;
 
-    std::string ascii2radix64(std::string str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    std::string ascii2radix64(const std::string & str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+
+    // encode len octets into out, which must hold 4 * ((len + 2) / 3) characters
+    // returns the number of characters written
+    std::size_t ascii2radix64(const uint8_t * in, const std::size_t len, char * out, const unsigned char char62 = '+', const unsigned char char63 = '/');
 
     // 6.4.  Decoding Radix-64
     //
@@ -110,7 +116,11 @@ namespace OpenPGP {
     //    such assurance is possible, however, when the number of octets
     //    transmitted was a multiple of three and no "=" characters are
     //    present.
-    std::string radix642ascii(std::string str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    std::string radix642ascii(const std::string & str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+
+    // decode len characters (a multiple of 4, padding only at the end) into out,
+    // which must hold 3 * len / 4 octets; returns the number of octets written
+    std::size_t radix642ascii(const char * in, const std::size_t len, uint8_t * out, const unsigned char char62 = '+', const unsigned char char63 = '/');
 
 }
 
@@ -3,6 +3,93 @@
 namespace OpenPGP {
 namespace S2K {
 
+Cache::Cache()
+    : mutex(),
+      max_entries(0),
+      ttl(0),
+      entries(),
+      index()
+{}
+
+// it is taken by value: callers pass references into index, which erasing invalidates
+void Cache::erase(const Entries::iterator it){
+    index.erase(it -> key);
+    std::fill(it -> key.begin(), it -> key.end(), 0);
+    std::fill(it -> value.begin(), it -> value.end(), 0);
+    entries.erase(it);
+}
+
+Cache & Cache::instance(){
+    static Cache cache;
+    return cache;
+}
+
+Cache::~Cache(){
+    clear();
+}
+
+void Cache::configure(const std::size_t max, const std::chrono::seconds & t){
+    std::lock_guard <std::mutex> lock(mutex);
+    max_entries = max;
+    ttl = t;
+    while (entries.size() > max_entries){
+        erase(std::prev(entries.end()));
+    }
+}
+
+bool Cache::enabled() const{
+    std::lock_guard <std::mutex> lock(mutex);
+    return max_entries;
+}
+
+bool Cache::get(const std::string & key, std::string & value){
+    std::lock_guard <std::mutex> lock(mutex);
+    std::unordered_map <std::string, Entries::iterator>::iterator it = index.find(key);
+    if (it == index.end()){
+        return false;
+    }
+
+    if ((Clock::now() - it -> second -> created) >= ttl){
+        erase(it -> second);
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, it -> second);
+    value = it -> second -> value;
+    return true;
+}
+
+void Cache::put(const std::string & key, const std::string & value){
+    std::lock_guard <std::mutex> lock(mutex);
+    if (!max_entries){
+        return;
+    }
+
+    std::unordered_map <std::string, Entries::iterator>::iterator it = index.find(key);
+    if (it != index.end()){
+        erase(it -> second);
+    }
+
+    while (entries.size() >= max_entries){
+        erase(std::prev(entries.end()));
+    }
+
+    entries.push_front(Entry{key, value, Clock::now()});
+    index[key] = entries.begin();
+}
+
+void Cache::clear(){
+    std::lock_guard <std::mutex> lock(mutex);
+    while (entries.size()){
+        erase(entries.begin());
+    }
+}
+
+std::size_t Cache::size() const{
+    std::lock_guard <std::mutex> lock(mutex);
+    return entries.size();
+}
+
 std::string S2K::show_title() const{
     return NAME.at(type) + " (s2k " + std::to_string(type) + "):";
 }
@@ -18,6 +105,23 @@ std::string S2K::write() const{
     return raw();
 }
 
+std::string S2K::run(const std::string & pass, unsigned int sym_key_len) const{
+    Cache & cache = Cache::instance();
+    if (!cache.enabled()){
+        return derive(pass, sym_key_len);
+    }
+
+    std::string key = raw() + unhexlify(makehex(sym_key_len, 8)) + Hash::use(Hash::ID::SHA256, pass);
+    std::string out;
+    if (!cache.get(key, out)){
+        out = derive(pass, sym_key_len);
+        cache.put(key, out);
+    }
+
+    std::fill(key.begin(), key.end(), 0);
+    return out;
+}
+
 uint8_t S2K::get_type() const{
     return type;
 }
@@ -61,7 +165,7 @@ std::string S2K0::raw() const{
     return "\x00" + std::string(1, hash);
 }
 
-std::string S2K0::run(const std::string & pass, unsigned int sym_key_len) const{
+std::string S2K0::derive(const std::string & pass, unsigned int sym_key_len) const{
     std::string out = "";
     unsigned int counter = 0;
     while (out.size() < sym_key_len){
@@ -104,7 +208,7 @@ std::string S2K1::raw() const{
     return "\x01" + std::string(1, hash) + salt;
 }
 
-std::string S2K1::run(const std::string & pass, unsigned int sym_key_len) const{
+std::string S2K1::derive(const std::string & pass, unsigned int sym_key_len) const{
     std::string out = "";
     unsigned int counter = 0;
     while (out.size() < sym_key_len){
@@ -133,6 +237,38 @@ uint32_t S2K3::coded_count(const uint8_t c){
     return (16 + (c & 15)) << ((c >> 4) + S2K3::EXPBIAS);
 }
 
+uint8_t S2K3::calibrate(const uint8_t hash, const std::chrono::milliseconds & target, const unsigned int sym_key_len){
+    typedef std::chrono::steady_clock Clock;
+
+    S2K3 s2k;
+    s2k.set_hash(hash);
+    s2k.set_salt(std::string(8, 0));
+
+    // double the work until the measurement is long enough to be meaningful
+    uint8_t probe = 96;
+    double seconds = 0;
+    while (true){
+        s2k.set_count(probe);
+        const Clock::time_point start = Clock::now();
+        s2k.derive("calibration", sym_key_len);
+        seconds = std::chrono::duration <double> (Clock::now() - start).count();
+        if ((seconds >= 0.01) || (probe > 239)){
+            break;
+        }
+        probe += 16;
+    }
+
+    // the time is proportional to the octet count
+    const double needed = S2K3::coded_count(probe) * (std::chrono::duration <double> (target).count() / seconds);
+    for(unsigned int c = 0; c < 256; c++){
+        if (S2K3::coded_count(c) >= needed){
+            return c;
+        }
+    }
+
+    return 255;
+}
+
 S2K3::S2K3()
     : S2K1(ID::ITERATED_AND_SALTED_S2K),
       count()
@@ -161,19 +297,37 @@ std::string S2K3::raw() const{
     return "\x03" + std::string(1, hash) + salt + unhexlify(makehex(count, 2));
 }
 
-std::string S2K3::run(const std::string & pass, unsigned int sym_key_len) const{
-    // get string to hash
-    std::string to_hash = "";
-    while (to_hash.size() < S2K3::coded_count(count)){// coded count is count of octets, not iterations
-        to_hash += salt + pass;
+std::string S2K3::derive(const std::string & pass, unsigned int sym_key_len) const{
+    // coded count is count of octets, not iterations,
+    // but salt + pass is always hashed completely at least once
+    const std::string pattern = salt + pass;
+    if (pattern.empty()){
+        throw std::runtime_error("Error: Nothing to hash.");
+    }
+    const uint64_t total = std::max <uint64_t> (S2K3::coded_count(count), pattern.size());
+
+    // whole copies of salt + pass, so every chunk starts at the beginning of the pattern
+    std::string chunk;
+    chunk.reserve(S2K3::CHUNK + pattern.size());
+    while (chunk.size() < S2K3::CHUNK){
+        chunk += pattern;
     }
-    to_hash = to_hash.substr(0, S2K3::coded_count(count));
-    // hash string
+    const uint8_t * data = reinterpret_cast <const uint8_t *> (chunk.data());
+
     std::string out = "";
     unsigned int context = 0;
     while (out.size() < sym_key_len){
-        out += Hash::use(hash, std::string(context++, 0) + to_hash);
+        MerkleDamgard::Ptr h = Hash::create(hash);
+        h -> update(std::string(context++, 0));
+        for(uint64_t done = 0; done < total;){
+            const std::size_t n = std::min <uint64_t> (chunk.size(), total - done);
+            h -> update(data, n);
+            done += n;
+        }
+        out += h -> digest();
     }
+
+    std::fill(chunk.begin(), chunk.end(), 0);
     return out.substr(0, sym_key_len);
 }
 
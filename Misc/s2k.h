@@ -26,9 +26,15 @@ THE SOFTWARE.
 #ifndef __S2K__
 #define __S2K__
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "../Hashes/Hashes.h"
 
@@ -81,6 +87,57 @@ namespace OpenPGP {
                     std::make_pair(110,                         "Private/Experimental S2K"),
         };
 
+        // Opt-in cache of S2K outputs, so repeatedly unlocking the same key
+        // with the same passphrase only runs the S2K once.
+        //
+        // Entries are keyed by the S2K specifier (type, hash, salt, count),
+        // the key length and a SHA-256 digest of the passphrase. The least
+        // recently used entry is dropped when the cache is full, and entries
+        // older than the TTL are never returned. Dropped keys and values are
+        // zeroed before their memory is released.
+        //
+        // The cache is shared by all threads and is disabled until configure
+        // is called with a non-zero size.
+        class Cache{
+            private:
+                typedef std::chrono::steady_clock Clock;
+
+                struct Entry{
+                    std::string key;
+                    std::string value;
+                    Clock::time_point created;
+                };
+
+                typedef std::list <Entry> Entries;          // most recently used first
+
+                mutable std::mutex mutex;
+                std::size_t max_entries;
+                std::chrono::seconds ttl;
+                Entries entries;
+                std::unordered_map <std::string, Entries::iterator> index;
+
+                Cache();
+
+                // caller holds the mutex
+                void erase(const Entries::iterator it);
+
+            public:
+                static Cache & instance();
+
+                ~Cache();
+
+                // max_entries = 0 disables the cache and drops all entries
+                void configure(const std::size_t max_entries, const std::chrono::seconds & ttl);
+                bool enabled() const;
+
+                // returns false if key is not cached or has expired
+                bool get(const std::string & key, std::string & value);
+                void put(const std::string & key, const std::string & value);
+
+                void clear();
+                std::size_t size() const;
+        };
+
         class S2K{
             protected:
                 uint8_t type; // octet 0
@@ -90,6 +147,9 @@ namespace OpenPGP {
 
                 S2K(uint8_t uint8_t);
 
+                // the actual S2K, without the cache
+                virtual std::string derive(const std::string & pass, unsigned int sym_key_len) const = 0;
+
             public:
                 typedef std::shared_ptr <S2K> Ptr;
 
@@ -98,7 +158,9 @@ namespace OpenPGP {
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const = 0;
                 virtual std::string raw() const = 0;
                 std::string write() const;
-                virtual std::string run(const std::string & pass, unsigned int sym_key_len) const = 0;
+
+                // uses Cache::instance() when it is enabled
+                std::string run(const std::string & pass, unsigned int sym_key_len) const;
 
                 uint8_t get_type() const;
                 uint8_t get_hash() const;
@@ -142,6 +204,8 @@ namespace OpenPGP {
             protected:
                 S2K0(uint8_t t);
 
+                virtual std::string derive(const std::string & pass, unsigned int sym_key_len) const;
+
             public:
                 typedef std::shared_ptr <S2K0> Ptr;
 
@@ -150,7 +214,6 @@ namespace OpenPGP {
                 virtual void read(const std::string & data, std::string::size_type & pos);
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 virtual std::string raw() const;
-                virtual std::string run(const std::string & pass, unsigned int sym_key_len) const;
 
                 S2K::Ptr clone() const;
         };
@@ -174,6 +237,8 @@ namespace OpenPGP {
 
                 S2K1(uint8_t t);
 
+                virtual std::string derive(const std::string & pass, unsigned int sym_key_len) const;
+
             public:
                 typedef std::shared_ptr <S2K1> Ptr;
 
@@ -182,7 +247,6 @@ namespace OpenPGP {
                 virtual void read(const std::string & data, std::string::size_type & pos);
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 virtual std::string raw() const;
-                virtual std::string run(const std::string & pass, unsigned int sym_key_len) const;
 
                 std::string get_salt() const;
 
@@ -230,20 +294,30 @@ namespace OpenPGP {
          class S2K3 : public S2K1 {
             private:
                 static const uint32_t EXPBIAS = 6;
-                static uint32_t coded_count(const uint8_t c);
+
+                // octets of repeated salt + pass given to the hash at a time
+                static const std::size_t CHUNK = 1 << 16;
 
             private:
                 uint8_t count;
 
+                std::string derive(const std::string & pass, unsigned int sym_key_len) const;
+
             public:
                 typedef std::shared_ptr <S2K3> Ptr;
 
+                // number of octets hashed for a coded count
+                static uint32_t coded_count(const uint8_t c);
+
+                // smallest coded count that takes at least target to run on this
+                // machine with the given hash, or 255 if none is slow enough
+                static uint8_t calibrate(const uint8_t hash, const std::chrono::milliseconds & target, const unsigned int sym_key_len = 32);
+
                 S2K3();
                 ~S2K3();
                 void read(const std::string & data, std::string::size_type & pos);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 std::string raw() const;
-                std::string run(const std::string & pass, unsigned int sym_key_len) const;
 
                 uint8_t get_count() const;
 
@@ -21,6 +21,24 @@ std::string addtrailer(const std::string & data, const Packet::Tag2::Ptr & sig){
     return ""; // should never reach here; mainly just to remove compiler warnings
 }
 
+void addtrailer(MerkleDamgard & hash, const Packet::Tag2::Ptr & sig){
+    if (!sig){
+        throw std::runtime_error("Error: No signature packet");
+    }
+
+    const std::string trailer = sig -> get_up_to_hashed();
+    if (sig -> get_version() == 3){
+        hash.update(reinterpret_cast <const uint8_t *> (trailer.data()) + 1, trailer.size() - 1); // remove version from trailer
+    }
+    else if (sig -> get_version() == 4){
+        hash.update(trailer);
+        hash.update("\x04\xff" + unhexlify(makehex(trailer.size(), 8)));
+    }
+    else{
+        throw std::runtime_error("Error: addtrailer for version " + std::to_string(sig -> get_version()) + " not defined.");
+    }
+}
+
 std::string overkey(const Packet::Key::Ptr & key){
     if (!key){
         throw std::runtime_error("Error: No Packet::Key packet.");
@@ -63,7 +81,7 @@ std::string to_sign_00(const std::string & data, const Packet::Tag2::Ptr & tag2)
         throw std::runtime_error("Error: No signature packet");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(data, tag2));
+    return hash_with_trailer(tag2, data);
 }
 
 std::string text_to_canonical(const std::string & data){
@@ -92,8 +110,9 @@ std::string to_sign_01(const std::string & data, const Packet::Tag2::Ptr & tag2)
         throw std::runtime_error("Error: No signature packet");
     }
 
-    const std::string canonical = text_to_canonical(data); // still has trailing <CR><LF>
-    return Hash::use(tag2 -> get_hash(), addtrailer(canonical.substr(0, canonical.size() - 2), tag2));
+    std::string canonical = text_to_canonical(data);
+    canonical.resize(canonical.size() - std::min <std::size_t> (canonical.size(), 2)); // drop the trailing <CR><LF>, unless empty
+    return hash_with_trailer(tag2, canonical);
 }
 
 std::string to_sign_02(const Packet::Tag2::Ptr & tag2){
@@ -104,7 +123,7 @@ std::string to_sign_02(const Packet::Tag2::Ptr & tag2){
     if (tag2 -> get_version() == 3){
         throw std::runtime_error("Error: It does not make sense to have a V3 standalone signature.");
     }
-    return Hash::use(tag2 -> get_hash(), addtrailer("", tag2));
+    return hash_with_trailer(tag2);
 }
 
 std::string to_sign_10(const Packet::Key::Ptr & key, const Packet::User::Ptr & id, const Packet::Tag2::Ptr & tag2){
@@ -124,7 +143,7 @@ std::string to_sign_10(const Packet::Key::Ptr & key, const Packet::User::Ptr & i
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(key) + certification(tag2 -> get_version(), id), tag2));
+    return hash_with_trailer(tag2, overkey(key), certification(tag2 -> get_version(), id));
 }
 
 std::string to_sign_11(const Packet::Key::Ptr & key, const Packet::User::Ptr & id, const Packet::Tag2::Ptr & tag2){
@@ -144,7 +163,7 @@ std::string to_sign_11(const Packet::Key::Ptr & key, const Packet::User::Ptr & i
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(key) + certification(tag2 -> get_version(), id), tag2));
+    return hash_with_trailer(tag2, overkey(key), certification(tag2 -> get_version(), id));
 }
 
 std::string to_sign_12(const Packet::Key::Ptr & key, const Packet::User::Ptr & id, const Packet::Tag2::Ptr & tag2){
@@ -164,7 +183,7 @@ std::string to_sign_12(const Packet::Key::Ptr & key, const Packet::User::Ptr & i
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(key) + certification(tag2 -> get_version(), id), tag2));
+    return hash_with_trailer(tag2, overkey(key), certification(tag2 -> get_version(), id));
 }
 
 std::string to_sign_13(const Packet::Key::Ptr & key, const Packet::User::Ptr & id, const Packet::Tag2::Ptr & tag2){
@@ -184,7 +203,7 @@ std::string to_sign_13(const Packet::Key::Ptr & key, const Packet::User::Ptr & i
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(key) + certification(tag2 -> get_version(), id), tag2));
+    return hash_with_trailer(tag2, overkey(key), certification(tag2 -> get_version(), id));
 }
 
 std::string to_sign_cert(const uint8_t cert, const Packet::Key::Ptr & key, const Packet::User::Ptr & id, const Packet::Tag2::Ptr & sig){
@@ -227,7 +246,7 @@ std::string to_sign_18(const Packet::Key::Ptr & primary, const Packet::Key::Ptr
         throw std::runtime_error("Error: No signature packet");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(primary) + overkey(key), tag2));
+    return hash_with_trailer(tag2, overkey(primary), overkey(key));
 }
 
 std::string to_sign_19(const Packet::Key::Ptr & primary, const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr & tag2){
@@ -235,7 +254,7 @@ std::string to_sign_19(const Packet::Key::Ptr & primary, const Packet::Key::Ptr
         throw std::runtime_error("Error: No signature packet");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(primary) + overkey(subkey), tag2));
+    return hash_with_trailer(tag2, overkey(primary), overkey(subkey));
 }
 
 std::string to_sign_1f(const Packet::Key::Ptr & k, const Packet::Tag2::Ptr & tag2){
@@ -243,7 +262,7 @@ std::string to_sign_1f(const Packet::Key::Ptr & k, const Packet::Tag2::Ptr & tag
         throw std::runtime_error("Error: No signature packet");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(k), tag2));
+    return hash_with_trailer(tag2, overkey(k));
 }
 
 std::string to_sign_20(const Packet::Key::Ptr & key, const Packet::Tag2::Ptr & tag2){
@@ -263,7 +282,7 @@ std::string to_sign_20(const Packet::Key::Ptr & key, const Packet::Tag2::Ptr & t
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(key), tag2));
+    return hash_with_trailer(tag2, overkey(key));
 }
 
 std::string to_sign_28(const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr & tag2){
@@ -283,7 +302,7 @@ std::string to_sign_28(const Packet::Key::Ptr & subkey, const Packet::Tag2::Ptr
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(subkey), tag2));
+    return hash_with_trailer(tag2, overkey(subkey));
 }
 
 std::string to_sign_30(const Packet::Key::Ptr & key, const Packet::User::Ptr & id, const Packet::Tag2::Ptr & tag2){
@@ -303,7 +322,7 @@ std::string to_sign_30(const Packet::Key::Ptr & key, const Packet::User::Ptr & i
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer(overkey(key) + certification(tag2 -> get_version(), id), tag2));
+    return hash_with_trailer(tag2, overkey(key), certification(tag2 -> get_version(), id));
 }
 
 std::string to_sign_40(const Packet::Tag2::Ptr & tag2){
@@ -315,7 +334,7 @@ std::string to_sign_40(const Packet::Tag2::Ptr & tag2){
         throw std::runtime_error("Error: Bad signature type.");
     }
 
-    return Hash::use(tag2 -> get_hash(), addtrailer("", tag2));
+    return hash_with_trailer(tag2);
 }
 
 std::string to_sign_50(const Packet::Tag2 & sig, const Packet::Tag2::Ptr & /*tag2*/){
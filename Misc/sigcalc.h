@@ -26,6 +26,7 @@ THE SOFTWARE.
 #ifndef __SIGNATURE__
 #define __SIGNATURE__
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -58,6 +59,31 @@ namespace OpenPGP {
     //    at the end of the Signature packet.
     std::string addtrailer(const std::string & data, const Packet::Tag2::Ptr & sig);
 
+    // feed the trailer into a hash that has already seen the data
+    void addtrailer(MerkleDamgard & hash, const Packet::Tag2::Ptr & sig);
+
+    // hash each part in order followed by the trailer of sig,
+    // using the hash algorithm of sig
+    inline void hash_parts(MerkleDamgard &){}
+
+    template <typename... Parts>
+    void hash_parts(MerkleDamgard & hash, const std::string & part, const Parts & ... parts){
+        hash.update(part);
+        hash_parts(hash, parts...);
+    }
+
+    template <typename... Parts>
+    std::string hash_with_trailer(const Packet::Tag2::Ptr & sig, const Parts & ... parts){
+        if (!sig){
+            throw std::runtime_error("Error: No signature packet");
+        }
+
+        MerkleDamgard::Ptr hash = Hash::create(sig -> get_hash());
+        hash_parts(*hash, parts...);
+        addtrailer(*hash, sig);
+        return hash -> digest();
+    }
+
     // Signature over a Packet::Key
     //
     //    When a signature is made over a Packet::Key, the hash data starts with the
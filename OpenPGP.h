@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "Key.h"                   // Transferable Keys
 #include "Message.h"               // OpenPGP Messages
 #include "RevocationCertificate.h" // OpenPGP Messages
+#include "PacketReader.h"          // read packets one at a time
 
 // OpenPGP Functions
 #include "decrypt.h"               // decrypt stuff
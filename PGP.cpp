@@ -44,7 +44,7 @@ unsigned int PGP::partialBodyLen(uint8_t first_octet) const{
     return 1 << (first_octet & 0x1f);
 }
 
-uint8_t PGP::read_packet_header(const std::string & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const{
+uint8_t PGP::read_packet_header(const Slice & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const{
     uint8_t ctb = data[pos];                                        // Name "ctb" came from Version 2 [RFC 1991]
     format = ctb & 0x40;                                            // get packet length type (OLD = false; NEW = true)
     length = 0;
@@ -114,81 +114,13 @@ uint8_t PGP::read_packet_header(const std::string & data, std::string::size_type
     return tag;
 }
 
-Packet::Tag::Ptr PGP::read_packet_raw(const bool format, const uint8_t tag, uint8_t & partial, const std::string & data, std::string::size_type & pos, const std::string::size_type & length) const{
+Packet::Tag::Ptr PGP::read_packet_raw(const bool format, const uint8_t tag, uint8_t & partial, const Slice & data, std::string::size_type & pos, const std::string::size_type & length) const{
     Packet::Tag::Ptr out;
     if (partial > 1){
-        out = std::make_shared <Packet::Partial> ();
+        out = Packet::make <Packet::Partial> ();
     }
     else{
-        if (tag == Packet::RESERVED){
-            throw std::runtime_error("Error: Tag number MUST NOT be 0.");
-        }
-        else if (tag == Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY){
-            out = std::make_shared <Packet::Tag1> ();
-        }
-        else if (tag == Packet::SIGNATURE){
-            out = std::make_shared <Packet::Tag2> ();
-        }
-        else if (tag == Packet::SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY){
-            out = std::make_shared <Packet::Tag3> ();
-        }
-        else if (tag == Packet::ONE_PASS_SIGNATURE){
-            out = std::make_shared <Packet::Tag4> ();
-        }
-        else if (tag == Packet::SECRET_KEY){
-            out = std::make_shared <Packet::Tag5> ();
-        }
-        else if (tag == Packet::PUBLIC_KEY){
-            out = std::make_shared <Packet::Tag6> ();
-        }
-        else if (tag == Packet::SECRET_SUBKEY){
-            out = std::make_shared <Packet::Tag7> ();
-        }
-        else if (tag == Packet::COMPRESSED_DATA){
-            out = std::make_shared <Packet::Tag8> ();
-        }
-        else if (tag == Packet::SYMMETRICALLY_ENCRYPTED_DATA){
-            out = std::make_shared <Packet::Tag9> ();
-        }
-        else if (tag == Packet::MARKER_PACKET){
-            out = std::make_shared <Packet::Tag10> ();
-        }
-        else if (tag == Packet::LITERAL_DATA){
-            out = std::make_shared <Packet::Tag11> ();
-        }
-        else if (tag == Packet::TRUST){
-            out = std::make_shared <Packet::Tag12> ();
-        }
-        else if (tag == Packet::USER_ID){
-            out = std::make_shared <Packet::Tag13> ();
-        }
-        else if (tag == Packet::PUBLIC_SUBKEY){
-            out = std::make_shared <Packet::Tag14> ();
-        }
-        else if (tag == Packet::USER_ATTRIBUTE){
-            out = std::make_shared <Packet::Tag17> ();
-        }
-        else if (tag == Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA){
-            out = std::make_shared <Packet::Tag18> ();
-        }
-        else if (tag == Packet::MODIFICATION_DETECTION_CODE){
-            out = std::make_shared <Packet::Tag19> ();
-        }
-        else if (tag == 60){
-            out = std::make_shared <Packet::Tag60> ();
-        }
-        else if (tag == 61){
-            out = std::make_shared <Packet::Tag61> ();
-        }
-        else if (tag == 62){
-            out = std::make_shared <Packet::Tag62> ();
-        }
-        else if (tag == 63){
-            out = std::make_shared <Packet::Tag63> ();
-        }
-        else{
-            throw std::runtime_error("Error: Tag not defined: " + std::to_string(tag) + ".");
-        }
+        out = Packet::create(tag);
     }
 
     // fill in data
@@ -196,7 +128,12 @@ Packet::Tag::Ptr PGP::read_packet_raw(const bool format, const uint8_t tag, uint
     out -> set_format(format);
     out -> set_partial(partial);
     out -> set_size(length);
-    out -> read(data.substr(pos, length));
+    if (lazy && !partial){
+        out -> read_lazy(data.slice(pos, length));
+    }
+    else{
+        out -> read(data.slice(pos, length));
+    }
 
     // update position to end of packet
     pos += length;
@@ -208,7 +145,7 @@ Packet::Tag::Ptr PGP::read_packet_raw(const bool format, const uint8_t tag, uint
     return out;
 }
 
-Packet::Tag::Ptr PGP::read_packet(const std::string & data, std::string::size_type & pos, uint8_t & partial) const{
+Packet::Tag::Ptr PGP::read_packet(const Slice & data, std::string::size_type & pos, uint8_t & partial) const{
     if (pos >= data.size()){
         return nullptr;
     }
@@ -222,26 +159,20 @@ Packet::Tag::Ptr PGP::read_packet(const std::string & data, std::string::size_ty
     return read_packet_raw(format, tag, partial, data, pos, length);
 }
 
-std::string PGP::format_string(std::string data, uint8_t line_length) const{
-    std::string out = "";
-    for(unsigned int i = 0; i < data.size(); i += line_length){
-        out += data.substr(i, line_length) + "\n";
-    }
-    return out;
-}
-
 PGP::PGP()
     : armored(Armored::YES),
       type(UNKNOWN),
       keys(),
-      packets()
+      packets(),
+      lazy(false)
 {}
 
 PGP::PGP(const PGP & copy)
     : armored(copy.armored),
       type(copy.type),
       keys(copy.keys),
-      packets(copy.get_packets_clone())
+      packets(copy.get_packets_clone()),
+      lazy(copy.lazy)
 {}
 
 PGP::PGP(const std::string & data)
@@ -327,36 +258,50 @@ void PGP::read(std::istream & stream){
             keys.push_back(Armor_Key(key, value));
         }
 
-        // read up to tail
-        std::string body;
-        while (std::getline(stream, line) && (line.substr(0, 13) != "-----END PGP ")){
-            body += line;
-        }
+        // decode up to tail while parsing
+        ArmorReader reader(stream);
+        std::istream body(&reader);
+        body.exceptions(std::ios::badbit);   // pass decoding errors through
+        read_raw(body);
 
         // check for a checksum
-        if (body[body.size() - 5] == '='){
-            uint32_t checksum = toint(radix642ascii(body.substr(body.size() - 4, 4)), 256);
-            body = radix642ascii(body.substr(0, body.size() - 5));
-            // check if the checksum is correct
-            if (crc24(body) != checksum){
-                std::cerr << "Warning: Given checksum does not match calculated value." << std::endl;
-            }
-        }
-        else{
-            body = radix642ascii(body);
+        if (!reader.has_checksum()){
             std::cerr << "Warning: No checksum found." << std::endl;
         }
-
-        // parse data
-        read_raw(body);
+        // check if the checksum is correct
+        else if (!reader.valid()){
+            std::cerr << "Warning: Given checksum does not match calculated value." << std::endl;
+        }
 
         armored = true;
     }
 }
 
+void PGP::read(const Buffer::Ptr & buffer){
+    // binary packets always start with a set high bit; armor is text
+    if (buffer -> size() && (buffer -> data()[0] & 0x80)){
+        read_raw(buffer);
+        armored = false;
+        type = UNKNOWN;
+    }
+    else{
+        // parse the armor straight out of the buffer
+        const Slice data(buffer);
+        SliceBuf buf(data);
+        std::istream s(&buf);
+        read(s);
+    }
+}
+
 void PGP::read_raw(const std::string & data){
+    read_raw(Buffer::own(data));
+}
+
+void PGP::read_raw(const Buffer::Ptr & buffer){
     packets.clear();
 
+    const Slice data(buffer);
+
     // read each packet
     uint8_t partial = 0;
     std::string::size_type pos = 0;
@@ -377,7 +322,7 @@ void PGP::read_raw(const std::string & data){
 }
 
 void PGP::read_raw(std::istream & stream){
-    read_raw(std::string(std::istreambuf_iterator <char> (stream), {}));
+    read_raw(Buffer::own(std::string(std::istreambuf_iterator <char> (stream), {})));
 }
 
 std::string PGP::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -397,19 +342,30 @@ std::string PGP::raw(const Packet::Tag::Format header) const{
 }
 
 std::string PGP::write(const PGP::Armored armor, const Packet::Tag::Format header) const{
-    const std::string packet_string = raw(header);  // raw PGP data = binary, no ASCII headers
+    std::stringstream out;
+    write(out, armor, header);
+    return out.str();
+}
 
-    if ((armor == Armored::NO)                   || // no armor
-        ((armor == Armored::DEFAULT) && !armored)){ // or use stored value, and stored value is no
-        return packet_string;
+void PGP::write_packets(std::ostream & out, const Packet::Tag::Format header) const{
+    for(Packet::Tag::Ptr const & p : packets){
+        const std::string packet = p -> write(header);
+        out.write(packet.data(), packet.size());
     }
+}
 
-    std::string out = "-----BEGIN PGP " + ASCII_Armor_Header[type] + "-----\n";
-    for(Armor_Key const & key : keys){
-        out += key.first + ": " + key.second + "\n";
+void PGP::write(std::ostream & stream, const PGP::Armored armor, const Packet::Tag::Format header) const{
+    if ((armor == Armored::NO)                   || // no armor
+        ((armor == Armored::DEFAULT) && !armored)){ // or use stored value, and stored value is no
+        write_packets(stream, header);
+        return;
     }
 
-    return out + "\n" + format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH) + "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) +  "\n-----END PGP " + ASCII_Armor_Header[type] + "-----\n";
+    ArmorWriter writer(stream, ASCII_Armor_Header[type], keys);
+    std::ostream out(&writer);
+    out.exceptions(std::ios::badbit);
+    write_packets(out, header);
+    writer.close();
 }
 
 bool PGP::get_armored() const{
@@ -424,6 +380,10 @@ const PGP::Armor_Keys & PGP::get_keys() const{
     return keys;
 }
 
+bool PGP::get_lazy() const{
+    return lazy;
+}
+
 const PGP::Packets & PGP::get_packets() const{
     return packets;
 }
@@ -444,6 +404,10 @@ void PGP::set_type(const PGP::Type_t t){
     type = t;
 }
 
+void PGP::set_lazy(const bool l){
+    lazy = l;
+}
+
 void PGP::set_keys(const PGP::Armor_Keys & k){
     keys = k;
 }
@@ -464,6 +428,7 @@ PGP & PGP::operator=(const PGP & copy){
     type = copy.type;
     keys = copy.keys;
     packets = copy.get_packets_clone();
+    lazy = copy.lazy;
     return *this;
 }
 
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <vector>
 #include <utility>
 
+#include "Misc/armor.h"
 #include "Misc/CRC-24.h"
 #include "Misc/radix64.h"
 #include "Packets/packets.h"
@@ -70,23 +71,24 @@ namespace OpenPGP {
             Type_t type;                                    // what type of key is this
             Armor_Keys keys;                                // key-value pairs in the ASCII header
             Packets packets;                                // main data
+            bool lazy;                                      // defer decoding packet bodies until they are used; default false
 
             // calculates the length of a partial body
             unsigned int partialBodyLen(uint8_t first_octet) const;
 
             // figures out where packet data starts and updates pos arguments
             // length, tag, format and partial arguments also filled
-            uint8_t read_packet_header(const std::string & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const;
+            uint8_t read_packet_header(const Slice & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const;
 
             // parses raw packet data
-            Packet::Tag::Ptr read_packet_raw(const bool format, const uint8_t tag, uint8_t & partial, const std::string & data, std::string::size_type & pos, const std::string::size_type & length) const;
+            Packet::Tag::Ptr read_packet_raw(const bool format, const uint8_t tag, uint8_t & partial, const Slice & data, std::string::size_type & pos, const std::string::size_type & length) const;
 
             // parse packet with header; wrapper for read_packet_header and read_packet_raw
             // partial should be initialized with 0
-            Packet::Tag::Ptr read_packet(const std::string & data, std::string::size_type & pos, uint8_t & partial) const;
+            Packet::Tag::Ptr read_packet(const Slice & data, std::string::size_type & pos, uint8_t & partial) const;
 
-            // modifies output string so each line is no longer than MAX_LINE_SIZE long
-            std::string format_string(std::string data, uint8_t line_length = MAX_LINE_LENGTH) const;
+            // write each packet to out as soon as it is serialized, so only one packet is held at a time
+            void write_packets(std::ostream & out, const Packet::Tag::Format header) const;
 
         public:
             typedef std::shared_ptr <PGP> Ptr;
@@ -97,22 +99,29 @@ namespace OpenPGP {
             PGP(std::istream & stream);
             ~PGP();
 
+            // Packets and subpackets parsed while an Arena::Scope is active are
+            // allocated from that arena and released together with it.
+
             // Read ASCII Header + Base64 data
             void read(const std::string & data);
             void read(std::istream & stream);
+            void read(const Buffer::Ptr & buffer);      // binary data is parsed in place; see read_raw
 
             // Read Binary data
             void read_raw(const std::string & data);
             void read_raw(std::istream & stream);
+            void read_raw(const Buffer::Ptr & buffer);  // large packet bodies are kept as slices of buffer instead of copies
 
             virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;   // display information; indents is used to tab the output if desired
             virtual std::string raw(const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;               // write packets only; header is for writing default (0), old (1) or new (2) header formats
-            virtual std::string write(const Armored armor = DEFAULT, const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;
+            std::string write(const Armored armor = DEFAULT, const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;
+            virtual void write(std::ostream & stream, const Armored armor = DEFAULT, const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;   // write directly to a stream, armoring on the fly
 
             // Accessors
             bool get_armored()              const;
             Type_t get_type()               const;
             const Armor_Keys & get_keys()   const;
+            bool get_lazy()                 const;
             const Packets & get_packets()   const;          // get copy of all packet pointers (for looping through packets)
             Packets get_packets_clone()     const;          // clone all packets (for modifying packets)
 
@@ -120,6 +129,7 @@ namespace OpenPGP {
             void set_armored(const bool a);
             void set_type(const Type_t t);
             void set_keys(const Armor_Keys & keys);
+            void set_lazy(const bool l);                    // takes effect on the next read; packets that support it then only decode on first access
             void set_packets(const Packets & p);            // copies the the input packet pointers
             void set_packets_clone(const Packets & p);      // clones the input packets
 
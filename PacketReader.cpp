@@ -0,0 +1,312 @@
+#include "PacketReader.h"
+
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PACKET_READER_FD_SUPPORTED
+#include <unistd.h>
+#endif
+
+namespace OpenPGP {
+
+PacketReader::FD::int_type PacketReader::FD::underflow(){
+    if (gptr() < egptr()){
+        return traits_type::to_int_type(*gptr());
+    }
+
+    #ifdef PACKET_READER_FD_SUPPORTED
+    ssize_t n;
+    do{
+        n = ::read(fd, buffer, sizeof(buffer));
+    } while ((n < 0) && (errno == EINTR));
+
+    if (n < 0){
+        throw std::runtime_error("Error: Failed to read from file descriptor.");
+    }
+
+    if (!n){
+        return traits_type::eof();
+    }
+
+    setg(buffer, buffer, buffer + n);
+    return traits_type::to_int_type(*gptr());
+    #else
+    throw std::runtime_error("Error: File descriptors are not supported on this platform.");
+    #endif
+}
+
+PacketReader::FD::FD(const int descriptor)
+    : std::streambuf(),
+      fd(descriptor)
+{
+    setg(buffer, buffer, buffer);
+}
+
+PacketReader::Body::int_type PacketReader::Body::underflow(){
+    if (gptr() < egptr()){
+        return traits_type::to_int_type(*gptr());
+    }
+
+    const std::size_t n = reader.read(buffer, sizeof(buffer));
+    if (!n){
+        return traits_type::eof();
+    }
+
+    setg(buffer, buffer, buffer + n);
+    return traits_type::to_int_type(*gptr());
+}
+
+PacketReader::Body::Body(PacketReader & r)
+    : std::streambuf(),
+      reader(r)
+{}
+
+void PacketReader::Body::reset(){
+    setg(buffer, buffer, buffer);
+}
+
+bool PacketReader::read_length(std::size_t & length){
+    const int first_octet = in.get();
+    if (first_octet == EOF){
+        throw std::runtime_error("Error: Packet length missing.");
+    }
+
+    if (first_octet < 192){                                 // 0 - 191; one-octet Body Length
+        length = first_octet;
+    }
+    else if (first_octet < 224){                            // 192 - 8383; two-octet Body Length
+        const int second_octet = in.get();
+        if (second_octet == EOF){
+            throw std::runtime_error("Error: Packet length missing.");
+        }
+        length = ((first_octet - 192) << 8) + second_octet + 192;
+    }
+    else if (first_octet == 255){                           // five-octet Body Length
+        char octets[4];
+        if (!in.read(octets, sizeof(octets))){
+            throw std::runtime_error("Error: Packet length missing.");
+        }
+        length = load_big_endian <uint32_t> (reinterpret_cast <const uint8_t *> (octets));
+    }
+    else{                                                   // Partial Body Length
+        length = static_cast <std::size_t> (1) << (first_octet & 0x1f);
+        return false;
+    }
+
+    return true;
+}
+
+bool PacketReader::next_chunk(){
+    if (last){
+        return false;
+    }
+
+    last = read_length(remaining);
+    return true;
+}
+
+std::size_t PacketReader::read(char * out, const std::size_t n){
+    if (!open){
+        return 0;
+    }
+
+    std::size_t got = 0;
+    while (got < n){
+        if (indeterminate){
+            in.read(out + got, n - got);
+            got += in.gcount();
+            if (!in){
+                in.clear(in.rdstate() & ~(std::ios::failbit | std::ios::eofbit));
+                open = false;
+                in.setstate(std::ios::eofbit);
+            }
+            break;
+        }
+
+        if (!remaining){
+            if (!next_chunk()){
+                open = false;
+                break;
+            }
+            continue;
+        }
+
+        const std::size_t want = std::min(remaining, n - got);
+        in.read(out + got, want);
+        const std::size_t read = in.gcount();
+        got += read;
+        remaining -= read;
+        if (read < want){
+            throw std::runtime_error("Error: Packet body is shorter than its length.");
+        }
+    }
+
+    return got;
+}
+
+PacketReader::PacketReader(std::istream & input)
+    : fd(),
+      fd_stream(),
+      in(input),
+      current(),
+      open(false),
+      remaining(0),
+      last(true),
+      indeterminate(false),
+      buf(*this),
+      stream(&buf)
+{
+    stream.exceptions(std::ios::badbit);    // pass parsing errors through
+}
+
+PacketReader::PacketReader(const int descriptor)
+    : fd(new FD(descriptor)),
+      fd_stream(new std::istream(fd.get())),
+      in(*fd_stream),
+      current(),
+      open(false),
+      remaining(0),
+      last(true),
+      indeterminate(false),
+      buf(*this),
+      stream(&buf)
+{
+    in.exceptions(std::ios::badbit);        // pass read errors through
+    stream.exceptions(std::ios::badbit);    // pass parsing errors through
+}
+
+bool PacketReader::next(PacketReader::Header & header){
+    skip();
+
+    const int ctb = in.get();                               // Name "ctb" came from Version 2 [RFC 1991]
+    if (ctb == EOF){
+        return false;
+    }
+
+    if (!(ctb & 0x80)){
+        throw std::runtime_error("Error: First bit of packet header MUST be 1.");
+    }
+
+    current.format = ctb & 0x40;
+    current.partial = false;
+    current.length = 0;
+    indeterminate = false;
+    last = true;
+
+    if (!current.format){                                   // Old length type RFC4880 sec 4.2.1
+        current.tag = (ctb >> 2) & 15;
+        const uint8_t octets[3] = {1, 2, 4};
+        if ((ctb & 3) == 3){                                // indeterminate length
+            current.partial = true;
+            indeterminate = true;
+        }
+        else{
+            char length[4];
+            if (!in.read(length, octets[ctb & 3])){
+                throw std::runtime_error("Error: Packet length missing.");
+            }
+            for(uint8_t i = 0; i < octets[ctb & 3]; i++){
+                current.length = (current.length << 8) | static_cast <uint8_t> (length[i]);
+            }
+        }
+    }
+    else{                                                   // New length type RFC4880 sec 4.2.2
+        current.tag = ctb & 63;
+        last = read_length(current.length);
+        current.partial = !last;
+    }
+
+    remaining = current.partial?(indeterminate?0:current.length):current.length;
+    if (current.partial){
+        current.length = 0;
+    }
+
+    open = true;
+    buf.reset();
+    stream.clear();
+
+    header = current;
+    return true;
+}
+
+std::istream & PacketReader::body(){
+    return stream;
+}
+
+void PacketReader::skip(){
+    buf.reset();
+
+    while (open){
+        if (indeterminate){
+            in.ignore(std::numeric_limits <std::streamsize>::max());
+            in.clear(in.rdstate() & ~std::ios::failbit);
+            open = false;
+            break;
+        }
+
+        if (remaining){
+            // seek over the chunk when possible; seeking past the end
+            // succeeds, so compare against the size of the stream first
+            bool seeked = false;
+            const std::istream::pos_type here = in.tellg();
+            if (here != std::istream::pos_type(-1)){
+                in.seekg(0, std::ios::end);
+                const std::istream::pos_type end = in.tellg();
+                if (in && (end != std::istream::pos_type(-1))){
+                    if (static_cast <std::size_t> (end - here) < remaining){
+                        in.seekg(end);
+                        throw std::runtime_error("Error: Packet body is shorter than its length.");
+                    }
+                    seeked = static_cast <bool> (in.seekg(here + static_cast <std::streamoff> (remaining)));
+                }
+            }
+            if (!seeked){
+                in.clear();
+                if (here != std::istream::pos_type(-1)){
+                    in.seekg(here);
+                }
+                in.ignore(remaining);
+                if (static_cast <std::size_t> (in.gcount()) < remaining){
+                    throw std::runtime_error("Error: Packet body is shorter than its length.");
+                }
+            }
+            remaining = 0;
+        }
+
+        if (!next_chunk()){
+            open = false;
+        }
+    }
+}
+
+std::string PacketReader::read_body(){
+    std::string out;
+
+    // data already pulled into the body stream
+    const std::streamsize buffered = buf.in_avail();
+    if (buffered > 0){
+        out.resize(buffered);
+        stream.read(&out[0], buffered);
+    }
+
+    char chunk[4096];
+    std::size_t n;
+    while ((n = read(chunk, sizeof(chunk)))){
+        out.append(chunk, n);
+    }
+
+    return out;
+}
+
+Packet::Tag::Ptr PacketReader::packet(){
+    std::string data = read_body();
+
+    Packet::Tag::Ptr out = Packet::create(current.tag);
+    out -> set_tag(current.tag);
+    out -> set_format(current.format);
+    out -> set_size(data.size());
+    out -> read(Slice(Buffer::own(std::move(data))));
+    return out;
+}
+
+}
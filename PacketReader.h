@@ -0,0 +1,134 @@
+/*
+PacketReader.h
+Pull-based reader of OpenPGP packets from a stream (RFC 4880 sec 4.2)
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_PACKET_READER__
+#define __OPENPGP_PACKET_READER__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+#include "Packets/packets.h"
+#include "common/Buffer.h"
+
+namespace OpenPGP {
+    // Reads one packet header at a time and exposes the body as a bounded
+    // stream, so that messages do not have to fit in memory and callers can
+    // stop, or skip bodies, whenever they want. Partial Body Lengths are
+    // joined, so body() always covers the whole packet body.
+    //
+    // Input comes from an istream or a file descriptor. A descriptor is read
+    // with read(2) through a 4096 octet window and is never seeked, so it
+    // can be a pipe or socket.
+    class PacketReader {
+        public:
+            struct Header {
+                uint8_t tag;
+                bool format;            // OLD (false) or NEW (true)
+                bool partial;           // body length is not known up front
+                std::size_t length;     // body length when not partial
+            };
+
+        private:
+            // reads a file descriptor that is not owned by the reader
+            class FD : public std::streambuf {
+                private:
+                    int fd;
+                    char buffer[4096];
+
+                protected:
+                    int_type underflow();
+
+                public:
+                    FD(const int descriptor);
+            };
+
+            // streams the body of the current packet from the underlying stream
+            class Body : public std::streambuf {
+                private:
+                    PacketReader & reader;
+                    char buffer[4096];
+
+                protected:
+                    int_type underflow();
+
+                public:
+                    Body(PacketReader & r);
+                    void reset();
+            };
+
+            std::unique_ptr <FD> fd;            // only set when reading a file descriptor
+            std::unique_ptr <std::istream> fd_stream;
+            std::istream & in;
+            Header current;
+            bool open;                  // a header was read and its body is not done
+            std::size_t remaining;      // octets left in the current length chunk
+            bool last;                  // current chunk is the final one
+            bool indeterminate;         // old format; body runs to the end of the stream
+            Body buf;
+            std::istream stream;
+
+            // read a New format body length; returns false for a Partial Body Length
+            bool read_length(std::size_t & length);
+
+            // move to the next chunk of a partial body; returns false when the body is done
+            bool next_chunk();
+
+            // read up to n body octets into out; returns the number read
+            std::size_t read(char * out, const std::size_t n);
+
+        public:
+            PacketReader(std::istream & input);
+            PacketReader(const int descriptor);     // the descriptor is not closed
+            PacketReader(const PacketReader & copy) = delete;
+
+            // read the next packet header, skipping whatever is left of the
+            // current body; returns false at the end of the stream
+            bool next(Header & header);
+
+            // rest of the current packet body
+            std::istream & body();
+
+            // discard the rest of the current body; seeks when the stream allows it,
+            // which file descriptors never do
+            void skip();
+
+            // read the rest of the current body
+            std::string read_body();
+
+            // read the rest of the current body and parse it
+            Packet::Tag::Ptr packet();
+
+            PacketReader & operator=(const PacketReader & copy) = delete;
+    };
+}
+
+#endif
@@ -127,7 +127,10 @@ Tag::Tag(const uint8_t t, uint8_t ver)
       version(ver),
       format(true),
       size(0),
-      partial(0)
+      partial(0),
+      deferred(),
+      lazy(false),
+      decode_mutex()
 {}
 
 Tag::Tag(const Tag & copy)
@@ -135,8 +138,15 @@ Tag::Tag(const Tag & copy)
       version(copy.version),
       format(copy.version),
       size(copy.size),
-      partial(copy.partial)
-{}
+      partial(copy.partial),
+      deferred(),
+      lazy(false),
+      decode_mutex()
+{
+    std::lock_guard <std::mutex> lock(copy.decode_mutex);
+    deferred = copy.deferred;
+    lazy = copy.lazy.load();
+}
 
 Tag::Tag()
     : Tag(UNKNOWN)
@@ -144,6 +154,50 @@ Tag::Tag()
 
 Tag::~Tag(){}
 
+void Tag::decode() const{
+    if (!lazy.load(std::memory_order_acquire)){
+        return;
+    }
+
+    std::lock_guard <std::mutex> lock(decode_mutex);
+    if (!lazy.load(std::memory_order_relaxed)){
+        return;
+    }
+
+    // decoding fills in fields of an object that is otherwise logically unchanged;
+    // if it throws, the packet stays undecoded
+    Tag & self = const_cast <Tag &> (*this);
+    self.read_deferred(deferred);
+    self.deferred = Slice();
+    self.lazy.store(false, std::memory_order_release);
+}
+
+void Tag::read_deferred(const Slice & data){
+    read(data);
+}
+
+bool Tag::get_deferred(std::string & out) const{
+    if (!lazy.load(std::memory_order_acquire)){
+        return false;
+    }
+
+    std::lock_guard <std::mutex> lock(decode_mutex);
+    if (!lazy.load(std::memory_order_relaxed)){
+        return false;
+    }
+
+    out = deferred.str();
+    return true;
+}
+
+void Tag::read(const Slice & data){
+    read(data.str());
+}
+
+void Tag::read_lazy(const Slice & data){
+    read(data);
+}
+
 std::string Tag::write(const Tag::Format header) const{
     if ((header == NEW) ||      // specified new header
         (tag > 15)){            // tag > 15, so new header is required
@@ -172,6 +226,10 @@ uint8_t Tag::get_partial() const{
     return partial;
 }
 
+bool Tag::is_decoded() const{
+    return !lazy.load(std::memory_order_acquire);
+}
+
 void Tag::set_tag(const uint8_t t){
     tag = t;
 }
@@ -199,6 +257,11 @@ Tag & Tag::operator=(const Tag & copy)
     format = copy.format;
     size = copy.size;
     partial = copy.partial;
+    if (this != &copy){
+        std::lock_guard <std::mutex> lock(copy.decode_mutex);
+        deferred = copy.deferred;
+        lazy = copy.lazy.load();
+    }
     return *this;
 }
 
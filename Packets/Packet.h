@@ -26,11 +26,14 @@ THE SOFTWARE.
 #ifndef __PACKET__
 #define __PACKET__
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
+#include "../common/Buffer.h"
 #include "../common/includes.h"
 
 namespace OpenPGP {
@@ -134,6 +137,19 @@ namespace OpenPGP {
                 std::size_t size;   // This value is only correct when the Tag was generated with the read() function
                 uint8_t partial;    // 0-3; 0 = not partial, 1 = partial begin, 2 = partial continue, 3 = partial end
 
+                Slice deferred;                     // body given to read_lazy that has not been decoded yet; guarded by decode_mutex
+                std::atomic <bool> lazy;            // whether deferred still has to be decoded
+                mutable std::mutex decode_mutex;    // lets const functions of a shared packet decode it from several threads
+
+                // runs read_deferred on a deferred body once; packets supporting read_lazy call this before touching their fields
+                void decode() const;
+
+                // decodes the body given to read_lazy; defaults to read
+                virtual void read_deferred(const Slice & data);
+
+                // copies the undecoded body into out and returns true if the packet has not been decoded
+                bool get_deferred(std::string & out) const;
+
                 // returns Tag data with old format Tag length
                 std::string write_old_length(const std::string & data) const;
 
@@ -153,6 +169,8 @@ namespace OpenPGP {
                 Tag();
                 virtual ~Tag();
                 virtual void read(const std::string & data) = 0;
+                virtual void read(const Slice & data);  // packets with large bodies keep slices of data instead of copies
+                virtual void read_lazy(const Slice & data); // keep data and decode it on first use; decodes immediately unless overridden
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const = 0;
                 virtual std::string raw() const = 0;
                 std::string write(const Format header = DEFAULT) const;
@@ -163,6 +181,7 @@ namespace OpenPGP {
                 uint8_t get_version() const;
                 std::size_t get_size() const;
                 uint8_t get_partial() const;
+                bool is_decoded() const;
 
                 // Modifiers
                 void set_tag(const uint8_t t);
@@ -26,6 +26,10 @@ Tag11::Tag11(const std::string & data)
 }
 
 void Tag11::read(const std::string & data){
+    read(Slice(data));
+}
+
+void Tag11::read(const Slice & data){
     size        = data.size();
     format      = data[0];
     uint8_t len = data[1];
@@ -36,7 +40,7 @@ void Tag11::read(const std::string & data){
     }
 
     time    = toint(data.substr(2 + len, 4), 256);
-    literal = data.substr(len + 6, data.size() - len - 6);
+    literal = data.slice(len + 6);
 }
 
 std::string Tag11::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -48,11 +52,11 @@ std::string Tag11::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Data (" + std::to_string(1 + filename.size() + 4 + literal.size()) + " octets):\n" +
            indent + tab + tab + "Filename: " + filename + "\n" +
            indent + tab + tab + "Creation Date: " + show_time(time) + "\n" +
-           indent + tab + tab + "Data: " + literal;
+           indent + tab + tab + "Data: " + literal.str();
 }
 
 std::string Tag11::raw() const{
-    return std::string(1, format) + std::string(1, filename.size()) + filename + unhexlify(makehex(time, 8)) + literal;
+    return std::string(1, format) + std::string(1, filename.size()) + filename + unhexlify(makehex(time, 8)) + literal.str();
 }
 
 uint8_t Tag11::get_format() const{
@@ -71,7 +75,7 @@ std::string Tag11::get_literal() const{
     if (filename == "_CONSOLE"){
         std::cerr << "Warning: Special name \"_CONSOLE\22 used. Message is considered to be \"for your eyes only\"." << std::endl;
     }
-    return literal;
+    return literal.str();
 }
 
 std::string Tag11::out(const bool writefile){
@@ -95,10 +99,10 @@ std::string Tag11::out(const bool writefile){
         if (!f){
             throw std::runtime_error("Error: Failed to open file to write literal data.");
         }
-        f << literal;
+        f.write(literal.data(), literal.size());
     }
     else{
-        return literal;
+        return literal.str();
     }
     return "Data written to file '" + filename + "'.";
 }
@@ -119,7 +123,7 @@ void Tag11::set_time(const uint32_t t){
 }
 
 void Tag11::set_literal(const std::string & l){
-    literal = l;
+    literal = Slice(l);
     size = raw().size();
 }
 
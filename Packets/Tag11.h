@@ -96,7 +96,7 @@ namespace OpenPGP {
                 uint8_t format;
                 std::string filename;
                 uint32_t time;
-                std::string literal;    // source data; no line ending conversion
+                Slice literal;          // source data; no line ending conversion
 
             public:
                 typedef std::shared_ptr <Packet::Tag11> Ptr;
@@ -105,6 +105,7 @@ namespace OpenPGP {
                 Tag11(const Tag11 & copy);
                 Tag11(const std::string & data);
                 void read(const std::string & data);
+                void read(const Slice & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 std::string raw() const;
 
@@ -1,10 +1,12 @@
 #include "Tag17.h"
 
+#include "../common/Arena.h"
+
 namespace OpenPGP {
 namespace Packet {
 
 // Extracts Subpacket data for figuring which subpacket type to create
-void Tag17::read_subpacket(const std::string & data, std::string::size_type & pos, std::string::size_type & length){
+void Tag17::read_subpacket(const Slice & data, std::string::size_type & pos, std::string::size_type & length){
     length = 0;
 
     const uint8_t first_octet = static_cast <unsigned char> (data[pos]);
@@ -51,6 +53,10 @@ Tag17::~Tag17(){
 }
 
 void Tag17::read(const std::string & data){
+    read(Slice(data));
+}
+
+void Tag17::read(const Slice & data){
     size = data.size();
 
     // read subpackets
@@ -61,13 +67,13 @@ void Tag17::read(const std::string & data){
 
         Subpacket::Tag17::Sub::Ptr subpacket = nullptr;
         if (data[pos] == Subpacket::Tag17::IMAGE_ATTRIBUTE){
-            subpacket = std::make_shared <Subpacket::Tag17::Sub1> ();
+            subpacket = arena_make_shared <Subpacket::Tag17::Sub1> ();
         }
         else {
             throw std::runtime_error("Error: Tag 17 Subpacket tag not defined or reserved: " + std::to_string(data[pos]));
         }
 
-        subpacket -> read(data.substr(pos + 1, length - 1));
+        subpacket -> read(data.slice(pos + 1, length - 1));
         attributes.push_back(subpacket);
 
         // go to end of current subpacket
@@ -79,7 +79,7 @@ namespace OpenPGP {
                 // only defined subpacket is 1
                 Attributes attributes;
 
-                void read_subpacket(const std::string & data, std::string::size_type & pos, std::string::size_type & length);
+                void read_subpacket(const Slice & data, std::string::size_type & pos, std::string::size_type & length);
 
             public:
                 typedef std::shared_ptr <Packet::Tag17> Ptr;
@@ -89,6 +89,7 @@ namespace OpenPGP {
                 Tag17(const std::string & data);
                 ~Tag17();
                 void read(const std::string & data);
+                void read(const Slice & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 std::string raw() const;
 
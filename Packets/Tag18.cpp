@@ -20,9 +20,13 @@ Tag18::Tag18(const std::string & data)
 }
 
 void Tag18::read(const std::string & data){
+    read(Slice(data));
+}
+
+void Tag18::read(const Slice & data){
     size = data.size();
     version = data[0];
-    protected_data = data.substr(1, data.size() - 1);
+    protected_data = data.slice(1);
 }
 
 std::string Tag18::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -30,19 +34,19 @@ std::string Tag18::show(const std::size_t indents, const std::size_t indent_size
     const std::string tab(indent_size, ' ');
     return indent + show_title() + "\n" +
            indent + tab + "Version: " + std::to_string(version) + "\n" +
-           indent + tab + "Encrypted Data (" + std::to_string(protected_data.size()) + " octets): " + hexlify(protected_data);
+           indent + tab + "Encrypted Data (" + std::to_string(protected_data.size()) + " octets): " + hexlify(protected_data.str());
 }
 
 std::string Tag18::raw() const{
-    return std::string(1, version) + protected_data;
+    return std::string(1, version) + protected_data.str();
 }
 
 std::string Tag18::get_protected_data() const{
-    return protected_data;
+    return protected_data.str();
 }
 
 void Tag18::set_protected_data(const std::string & p){
-    protected_data = p;
+    protected_data = Slice(p);
     size = raw().size();
 }
 
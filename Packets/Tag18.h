@@ -131,7 +131,7 @@ namespace OpenPGP {
 
         class Tag18 : public Tag {
             private:
-                std::string protected_data;
+                Slice protected_data;
 
             public:
                 typedef std::shared_ptr <Packet::Tag18> Ptr;
@@ -140,6 +140,7 @@ namespace OpenPGP {
                 Tag18(const Tag18 & copy);
                 Tag18(const std::string & data);
                 void read(const std::string & data);
+                void read(const Slice & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 std::string raw() const;
 
@@ -1,5 +1,7 @@
 #include "Tag2.h"
 
+#include "../common/Arena.h"
+
 namespace OpenPGP {
 namespace Packet {
 
@@ -21,13 +23,15 @@ Tag2::Tag2(const Tag2 & copy)
       type(copy.type),
       pka(copy.pka),
       hash(copy.hash),
-      mpi(copy.mpi),
-      left16(copy.left16),
-      time(copy.time),
-      keyid(copy.keyid),
-      hashed_subpackets(copy.get_hashed_subpackets_clone()),
-      unhashed_subpackets(copy.get_unhashed_subpackets_clone())
-{}
+      mpi(),
+      left16(),
+      time(0),
+      keyid(),
+      hashed_subpackets(),
+      unhashed_subpackets()
+{
+    copy_body(copy);
+}
 
 Tag2::Tag2(const std::string & data)
     : Tag2()
@@ -74,80 +78,80 @@ void Tag2::read_subpackets(const std::string & data, Tag2::Subpackets & subpacke
         // ignore critical bit until later
         const uint8_t type = data[pos] & 0x7f;
         if (type == Subpacket::Tag2::SIGNATURE_CREATION_TIME){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub2> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub2> ();
         }
         else if (type == Subpacket::Tag2::SIGNATURE_EXPIRATION_TIME){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub3> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub3> ();
         }
         else if (type == Subpacket::Tag2::EXPORTABLE_CERTIFICATION){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub4> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub4> ();
         }
         else if (type == Subpacket::Tag2::TRUST_SIGNATURE){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub5> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub5> ();
         }
         else if (type == Subpacket::Tag2::REGULAR_EXPRESSION){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub6> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub6> ();
         }
         else if (type == Subpacket::Tag2::REVOCABLE){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub7> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub7> ();
         }
         else if (type == Subpacket::Tag2::KEY_EXPIRATION_TIME){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub9> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub9> ();
         }
         else if (type == Subpacket::Tag2::PLACEHOLDER_FOR_BACKWARD_COMPATIBILITY){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub10> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub10> ();
         }
         else if (type == Subpacket::Tag2::PREFERRED_SYMMETRIC_ALGORITHMS){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub11> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub11> ();
         }
         else if (type == Subpacket::Tag2::REVOCATION_KEY){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub12> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub12> ();
         }
         else if (type == Subpacket::Tag2::ISSUER){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub16> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub16> ();
         }
         else if (type == Subpacket::Tag2::NOTATION_DATA){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub20> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub20> ();
         }
         else if (type == Subpacket::Tag2::PREFERRED_HASH_ALGORITHMS){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub21> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub21> ();
         }
         else if (type == Subpacket::Tag2::PREFERRED_COMPRESSION_ALGORITHMS){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub22> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub22> ();
         }
         else if (type == Subpacket::Tag2::KEY_SERVER_PREFERENCES){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub23> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub23> ();
         }
         else if (type == Subpacket::Tag2::PREFERRED_KEY_SERVER){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub24> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub24> ();
         }
         else if (type == Subpacket::Tag2::PRIMARY_USER_ID){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub25> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub25> ();
         }
         else if (type == Subpacket::Tag2::POLICY_URI){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub26> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub26> ();
         }
         else if (type == Subpacket::Tag2::KEY_FLAGS){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub27> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub27> ();
         }
         else if (type == Subpacket::Tag2::SIGNERS_USER_ID){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub28> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub28> ();
         }
         else if (type == Subpacket::Tag2::REASON_FOR_REVOCATION){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub29> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub29> ();
         }
         else if (type == Subpacket::Tag2::FEATURES){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub30> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub30> ();
         }
         else if (type == Subpacket::Tag2::SIGNATURE_TARGET){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub31> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub31> ();
         }
         else if (type == Subpacket::Tag2::EMBEDDED_SIGNATURE){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub32> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub32> ();
         }
         #ifdef GPG_COMPATIBLE
         else if (type == Subpacket::Tag2::ISSUER_FINGERPRINT){
-            subpacket = std::make_shared <Subpacket::Tag2::Sub33> ();
+            subpacket = arena_make_shared <Subpacket::Tag2::Sub33> ();
         }
         #endif
         else{
@@ -164,20 +168,61 @@ void Tag2::read_subpackets(const std::string & data, Tag2::Subpackets & subpacke
     }
 }
 
-void Tag2::read(const std::string & data){
-    size = data.size();
-    tag = 2;
-    version = data[0];
+void Tag2::copy_body(const Tag2 & copy){
+    mpi.clear();
+    left16.clear();
+    time = 0;
+    keyid.clear();
+    hashed_subpackets.clear();
+    unhashed_subpackets.clear();
+
+    // an undecoded copy stays undecoded; it is decoded from its own body when needed
+    if (lazy){
+        return;
+    }
+
+    mpi = copy.mpi;
+    left16 = copy.left16;
+    time = copy.time;
+    keyid = copy.keyid;
+    hashed_subpackets = clone_subpackets(copy.hashed_subpackets);
+    unhashed_subpackets = clone_subpackets(copy.unhashed_subpackets);
+}
+
+Tag2::Subpackets Tag2::clone_subpackets(const Tag2::Subpackets & subpackets){
+    Subpackets out;
+    for(Subpacket::Tag2::Sub::Ptr const & s : subpackets){
+        out.push_back(s -> clone());
+    }
+    return out;
+}
+
+void Tag2::read_body(const std::string & data, const bool header){
+    if (header){
+        size = data.size();
+        tag = 2;
+        version = data[0];
+    }
+
+    // nothing from a previous body may survive
+    mpi.clear();
+    left16.clear();
+    time = 0;
+    keyid.clear();
+    hashed_subpackets.clear();
+    unhashed_subpackets.clear();
+
     if (version < 4){
         if (data[1] != 5){
             throw std::runtime_error("Error: Length of hashed material must be 5.");
         }
-        type   = data[2];
+        if (header){
+            type   = data[2];
+            pka    = data[15];
+            hash   = data[16];
+        }
         time   = toint(data.substr(3, 4), 256);
         keyid  = data.substr(7, 8);
-
-        pka    = data[15];
-        hash   = data[16];
         left16 = data.substr(17, 2);
         std::string::size_type pos = 19;
 
@@ -200,9 +245,11 @@ void Tag2::read(const std::string & data){
         }
     }
     else if (version == 4){
-        type = data[1];
-        pka  = data[2];
-        hash = data[3];
+        if (header){
+            type = data[1];
+            pka  = data[2];
+            hash = data[3];
+        }
 
         // hashed subpackets
         const uint16_t hashed_size = toint(data.substr(4, 2), 256);
@@ -235,7 +282,53 @@ void Tag2::read(const std::string & data){
     }
 }
 
+void Tag2::read(const std::string & data){
+    deferred = Slice();
+    lazy = false;
+    read_body(data, true);
+}
+
+void Tag2::read_lazy(const Slice & data){
+    if (!data.size()){
+        throw std::runtime_error("Error: Tag2 has no data.");
+    }
+
+    // fixed position fields are cheap enough to read now, and are all that
+    // is needed to classify signatures; anything without them is decoded
+    // immediately so that errors are reported as usual
+    const uint8_t ver = data[0];
+    if (!(((ver == 3) && (data.size() > 16)) ||
+          ((ver == 4) && (data.size() > 3)))){
+        read(data.str());
+        return;
+    }
+
+    size = data.size();
+    tag = 2;
+    version = ver;
+    if (version == 3){
+        type = data[2];
+        pka  = data[15];
+        hash = data[16];
+    }
+    else{
+        type = data[1];
+        pka  = data[2];
+        hash = data[3];
+    }
+
+    deferred = data;
+    lazy = true;
+}
+
+void Tag2::read_deferred(const Slice & data){
+    // the header fields were filled in by read_lazy and may be read
+    // concurrently, so they are not written again
+    read_body(data.str(), false);
+}
+
 std::string Tag2::show(const std::size_t indents, const std::size_t indent_size) const{
+    decode();
     const std::string indent(indents * indent_size, ' ');
     const std::string tab(indent_size, ' ');
     const decltype(Signature_Type::NAME)::const_iterator sigtype_it = Signature_Type::NAME.find(type);
@@ -320,7 +413,12 @@ std::string Tag2::show(const std::size_t indents, const std::size_t indent_size)
 }
 
 std::string Tag2::raw() const{
-    std::string out(1, version);
+    std::string out;
+    if (get_deferred(out)){
+        return out;
+    }
+
+    out = std::string(1, version);
     if (version < 4){// to recreate older keys
         out += "\x05" + std::string(1, type) + unhexlify(makehex(time, 8)) + keyid + std::string(1, pka) + std::string(1, hash) + left16;
     }
@@ -354,14 +452,17 @@ uint8_t Tag2::get_hash() const{
 }
 
 std::string Tag2::get_left16() const{
+    decode();
     return left16;
 }
 
 PKA::Values Tag2::get_mpi() const{
+    decode();
     return mpi;
 }
 
 std::array <uint32_t, 3> Tag2::get_times() const{
+    decode();
     std::array <uint32_t, 3> times = {0, 0, 0};
     if (version == 3){
         times[0] = time;
@@ -413,6 +514,7 @@ std::array <uint32_t, 3> Tag2::get_times() const{
 }
 
 std::string Tag2::get_keyid() const{
+    decode();
     if (version == 3){
         return keyid;
     }
@@ -439,30 +541,27 @@ std::string Tag2::get_keyid() const{
 }
 
 Tag2::Subpackets Tag2::get_hashed_subpackets() const{
+    decode();
     return hashed_subpackets;
 }
 
 Tag2::Subpackets Tag2::get_hashed_subpackets_clone() const{
-    Subpackets out;
-    for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets){
-        out.push_back(s -> clone());
-    }
-    return out;
+    decode();
+    return clone_subpackets(hashed_subpackets);
 }
 
 Tag2::Subpackets Tag2::get_unhashed_subpackets() const{
+    decode();
     return unhashed_subpackets;
 }
 
 Tag2::Subpackets Tag2::get_unhashed_subpackets_clone() const{
-    Subpackets out;
-    for(Subpacket::Tag2::Sub::Ptr const & s : unhashed_subpackets){
-        out.push_back(s -> clone());
-    }
-    return out;
+    decode();
+    return clone_subpackets(unhashed_subpackets);
 }
 
 std::string Tag2::get_up_to_hashed() const{
+    decode();
     if (version == 3){
         return "\x03" + std::string(1, type) + unhexlify(makehex(time, 8));
     }
@@ -480,6 +579,7 @@ std::string Tag2::get_up_to_hashed() const{
 }
 
 std::string Tag2::get_without_unhashed() const{
+    decode();
     std::string out(1, version);
     if (version < 4){// to recreate older keys
         out += "\x05" + std::string(1, type) + unhexlify(makehex(time, 8)) + keyid + std::string(1, pka) + std::string(1, hash) + left16;
@@ -498,31 +598,37 @@ std::string Tag2::get_without_unhashed() const{
 }
 
 void Tag2::set_type(const uint8_t t){
+    decode();
     type = t;
     size = raw().size();
 }
 
 void Tag2::set_pka(const uint8_t p){
+    decode();
     pka = p;
     size = raw().size();
 }
 
 void Tag2::set_hash(const uint8_t h){
+    decode();
     hash = h;
     size = raw().size();
 }
 
 void Tag2::set_left16(const std::string & l){
+    decode();
     left16 = l;
     size = raw().size();
 }
 
 void Tag2::set_mpi(const PKA::Values & m){
+    decode();
     mpi = m;
     size = raw().size();
 }
 
 void Tag2::set_time(const uint32_t t){
+    decode();
     if (version == 3){
         time = t;
     }
@@ -546,6 +652,7 @@ void Tag2::set_time(const uint32_t t){
 }
 
 void Tag2::set_keyid(const std::string & k){
+    decode();
     if (k.size() != 8){
         throw std::runtime_error("Error: Key ID must be 8 octets.");
     }
@@ -573,6 +680,7 @@ void Tag2::set_keyid(const std::string & k){
 }
 
 void Tag2::set_hashed_subpackets(const Tag2::Subpackets & h){
+    decode();
     hashed_subpackets.clear();
     for(Subpacket::Tag2::Sub::Ptr const & s : h){
         hashed_subpackets.push_back(s -> clone());
@@ -581,6 +689,7 @@ void Tag2::set_hashed_subpackets(const Tag2::Subpackets & h){
 }
 
 void Tag2::set_unhashed_subpackets(const Tag2::Subpackets & u){
+    decode();
     unhashed_subpackets.clear();
     for(Subpacket::Tag2::Sub::Ptr const & s : u){
         unhashed_subpackets.push_back(s -> clone());
@@ -589,6 +698,7 @@ void Tag2::set_unhashed_subpackets(const Tag2::Subpackets & u){
 }
 
 std::string Tag2::find_subpacket(const uint8_t sub) const{
+    decode();
     // 5.2.4.1. Subpacket Hints
     //
     //   It is certainly possible for a signature to contain conflicting
@@ -615,23 +725,19 @@ std::string Tag2::find_subpacket(const uint8_t sub) const{
 }
 
 Tag::Ptr Tag2::clone() const{
-    Ptr out = std::make_shared <Tag2> (*this);
-    out -> hashed_subpackets = get_hashed_subpackets_clone();
-    out -> unhashed_subpackets = get_unhashed_subpackets_clone();
-    return out;
+    return std::make_shared <Tag2> (*this);
 }
 
 Tag2 & Tag2::operator=(const Tag2 & copy){
+    if (this == &copy){
+        return *this;
+    }
+
     Tag::operator=(copy);
     type = copy.type;
     pka = copy.pka;
     hash = copy.hash;
-    mpi = copy.mpi;
-    left16 = copy.left16;
-    time = copy.time;
-    keyid = copy.keyid;
-    hashed_subpackets = copy.get_hashed_subpackets_clone();
-    unhashed_subpackets = copy.get_unhashed_subpackets_clone();
+    copy_body(copy);
     return *this;
 }
 
@@ -86,6 +86,18 @@ namespace OpenPGP {
                 // Function to parse all subpackets
                 void read_subpackets(const std::string & data, Subpackets & subpackets);
 
+                static Subpackets clone_subpackets(const Subpackets & subpackets);
+
+                // parses data; header is false when read_lazy already filled in the fixed position fields
+                void read_body(const std::string & data, const bool header);
+
+                // copies everything except the fixed position fields, unless this packet has not been decoded;
+                // the old body is always dropped
+                void copy_body(const Tag2 & copy);
+
+            protected:
+                void read_deferred(const Slice & data);
+
             public:
                 typedef std::shared_ptr <Packet::Tag2> Ptr;
 
@@ -94,6 +106,7 @@ namespace OpenPGP {
                 Tag2(const std::string & data);
                 ~Tag2();
                 void read(const std::string & data);
+                void read_lazy(const Slice & data);                         // only the version, type, pka and hash are read until another function needs the body
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 std::string raw()                               const;
 
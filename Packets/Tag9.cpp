@@ -20,6 +20,10 @@ Tag9::Tag9(const std::string & data)
 }
 
 void Tag9::read(const std::string & data){
+    read(Slice(data));
+}
+
+void Tag9::read(const Slice & data){
     size = data.size();
     encrypted_data = data;
 }
@@ -28,19 +32,19 @@ std::string Tag9::show(const std::size_t indents, const std::size_t indent_size)
     const std::string indent(indents * indent_size, ' ');
     const std::string tab(indent_size, ' ');
     return indent + show_title() + "\n" +
-           indent + tab + "Encrypted Data (" + std::to_string(encrypted_data.size()) + " octets): " + hexlify(encrypted_data);
+           indent + tab + "Encrypted Data (" + std::to_string(encrypted_data.size()) + " octets): " + hexlify(encrypted_data.str());
 }
 
 std::string Tag9::raw() const{
-    return encrypted_data;
+    return encrypted_data.str();
 }
 
 std::string Tag9::get_encrypted_data() const{
-    return encrypted_data;
+    return encrypted_data.str();
 }
 
 void Tag9::set_encrypted_data(const std::string & e){
-    encrypted_data = e;
+    encrypted_data = Slice(e);
     size = raw().size();
 }
 
@@ -76,7 +76,7 @@ namespace OpenPGP {
 
         class Tag9 : public Tag {
             private:
-                std::string encrypted_data;
+                Slice encrypted_data;
 
             public:
                 typedef std::shared_ptr <Packet::Tag9> Ptr;
@@ -85,6 +85,7 @@ namespace OpenPGP {
                 Tag9(const Tag9 & copy);
                 Tag9(const std::string & data);
                 void read(const std::string & data);
+                void read(const Slice & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 std::string raw() const;
 
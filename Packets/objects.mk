@@ -1,4 +1,5 @@
 PACKETS_OBJECTS=Packet.o   \
+                packets.o  \
                 Partial.o  \
                 Key.o      \
                 User.o     \
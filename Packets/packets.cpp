@@ -0,0 +1,67 @@
+#include "packets.h"
+
+namespace OpenPGP {
+namespace Packet {
+
+namespace {
+
+// indexed by tag; tags without a type are null
+Factory FACTORY[64] = {
+    nullptr,                // RESERVED
+    make <Tag1>,            // PUBLIC_KEY_ENCRYPTED_SESSION_KEY
+    make <Tag2>,            // SIGNATURE
+    make <Tag3>,            // SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY
+    make <Tag4>,            // ONE_PASS_SIGNATURE
+    make <Tag5>,            // SECRET_KEY
+    make <Tag6>,            // PUBLIC_KEY
+    make <Tag7>,            // SECRET_SUBKEY
+    make <Tag8>,            // COMPRESSED_DATA
+    make <Tag9>,            // SYMMETRICALLY_ENCRYPTED_DATA
+    make <Tag10>,           // MARKER_PACKET
+    make <Tag11>,           // LITERAL_DATA
+    make <Tag12>,           // TRUST
+    make <Tag13>,           // USER_ID
+    make <Tag14>,           // PUBLIC_SUBKEY
+    nullptr,
+    nullptr,
+    make <Tag17>,           // USER_ATTRIBUTE
+    make <Tag18>,           // SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA
+    make <Tag19>,           // MODIFICATION_DETECTION_CODE
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,   // 20 - 29
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,   // 30 - 39
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,   // 40 - 49
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,   // 50 - 59
+    make <Tag60>,           // Private or Experimental Values
+    make <Tag61>,
+    make <Tag62>,
+    make <Tag63>,
+};
+
+}
+
+Tag::Ptr create(const uint8_t tag){
+    if (tag == RESERVED){
+        throw std::runtime_error("Error: Tag number MUST NOT be 0.");
+    }
+
+    if ((tag >= 64) || !FACTORY[tag]){
+        throw std::runtime_error("Error: Tag not defined: " + std::to_string(tag) + ".");
+    }
+
+    return FACTORY[tag]();
+}
+
+void register_tag(const uint8_t tag, const Factory factory){
+    if ((tag < 60) || (63 < tag)){
+        throw std::runtime_error("Error: Only Private or Experimental tags (60 - 63) may be registered.");
+    }
+
+    if (!factory){
+        throw std::runtime_error("Error: No factory given for tag " + std::to_string(tag) + ".");
+    }
+
+    FACTORY[tag] = factory;
+}
+
+}
+}
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #ifndef __PACKETS__
 #define __PACKETS__
 
+#include "../common/Arena.h"
 #include "Packet.h"
 #include "Partial.h"
 
@@ -55,4 +56,24 @@ THE SOFTWARE.
 #include "Tag62.h"  // Private or Experimental Values
 #include "Tag63.h"  // Private or Experimental Values
 
+namespace OpenPGP {
+    namespace Packet {
+        // packet and shared_ptr control block in one allocation, taken from
+        // the current arena if there is one
+        template <typename T>
+        Tag::Ptr make(){
+            return arena_make_shared <T> ();
+        }
+
+        typedef Tag::Ptr (*Factory)();
+
+        // create an empty packet of the given type
+        Tag::Ptr create(const uint8_t tag);
+
+        // replace the type created for one of the Private or Experimental tags (60 - 63)
+        // with, for example, Packet::make <MyTag60>; not thread safe, so register before parsing
+        void register_tag(const uint8_t tag, const Factory factory);
+    }
+}
+
 #endif
@@ -44,6 +44,10 @@ Sub & Sub::operator=(const Sub & copy){
 
 Sub::~Sub(){}
 
+void Sub::read(const Slice & data){
+    read(data.str());
+}
+
 std::string Sub::write() const{
     return write_SUBPACKET(std::string(1, type | (critical?0x80:0x00)) + raw());
 }
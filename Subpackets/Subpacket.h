@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <stdexcept>
 #include <string>
 
+#include "../common/Buffer.h"
 #include "../common/includes.h"
 
 namespace OpenPGP {
@@ -111,6 +112,7 @@ namespace OpenPGP {
 
                 virtual ~Sub();
                 virtual void read(const std::string & data) = 0;
+                virtual void read(const Slice & data);  // subpackets with large bodies keep slices of data instead of copies
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const = 0;
                 virtual std::string raw()   const = 0; // returns raw subpacket data, with no header
                 std::string write()         const;
@@ -21,10 +21,14 @@ Sub1::Sub1(const std::string & data)
 }
 
 void Sub1::read(const std::string & data){
+    read(Slice(data));
+}
+
+void Sub1::read(const Slice & data){
     if (data.size()){
         version = data[2];
         encoding = data[3];
-        image = data.substr(16, data.size() - 16); // remove image header - 12 '\x00's
+        image = data.slice(16);                     // remove image header - 12 '\x00's
         size = image.size();
     }
 }
@@ -39,7 +43,7 @@ std::string Sub1::show(const std::size_t indents, const std::size_t indent_size)
     const std::string filename = "image" + std::to_string(current) + "." + ((ia_it == Image_Attributes::NAME.end())?"Unknown":(ia_it -> second));
     std::ofstream f(filename, std::ios::binary);
     if (f){
-        f << image;
+        f.write(image.data(), image.size());
         f.close();
         out += "Check working directory for";
     }
@@ -51,7 +55,7 @@ std::string Sub1::show(const std::size_t indents, const std::size_t indent_size)
 }
 
 std::string Sub1::raw() const{
-    return "\x10" + zero + "\x01\x01" + std::string(12, 0) + image;
+    return "\x10" + zero + "\x01\x01" + std::string(12, 0) + image.str();
 }
 
 uint8_t Sub1::get_encoding() const{
@@ -59,7 +63,7 @@ uint8_t Sub1::get_encoding() const{
 }
 
 std::string Sub1::get_image() const{
-    return image;
+    return image.str();
 }
 
 void Sub1::set_encoding(const uint8_t & enc){
@@ -67,7 +71,7 @@ void Sub1::set_encoding(const uint8_t & enc){
 }
 
 void Sub1::set_image(const std::string & i){
-    image = i;
+    image = Slice(i);
 }
 
 Sub::Ptr Sub1::clone() const{
@@ -87,7 +87,7 @@ namespace OpenPGP {
                 private:
                     uint8_t version;
                     uint8_t encoding;
-                    std::string image;
+                    Slice image;
 
                     static unsigned int count;  // count of all images found; incremented by creating new instances of Sub1
                     unsigned int current;       // which image this instance is
@@ -98,6 +98,7 @@ namespace OpenPGP {
                     Sub1();
                     Sub1(const std::string & data);
                     void read(const std::string & data);
+                    void read(const Slice & data);
                     std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                     std::string raw() const;
 
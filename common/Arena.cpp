@@ -0,0 +1,81 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace OpenPGP {
+
+namespace {
+
+thread_local Arena::Ptr current_arena;
+
+}
+
+const std::size_t Arena::DEFAULT_CHUNK;
+
+Arena::Scope::Scope(const Arena::Ptr & arena)
+    : previous(current_arena),
+      active(arena != nullptr)
+{
+    if (active){
+        current_arena = arena;
+    }
+}
+
+Arena::Scope::~Scope(){
+    if (active){
+        current_arena = previous;
+    }
+}
+
+Arena::Arena(const std::size_t chunk)
+    : chunks(),
+      chunk_size(chunk),
+      pos(nullptr),
+      left(0),
+      used(0),
+      reserved(0)
+{
+    if (!chunk_size){
+        throw std::runtime_error("Error: Arena chunk size must not be 0.");
+    }
+}
+
+Arena::~Arena(){
+    for(char * chunk : chunks){
+        ::operator delete(chunk);
+    }
+}
+
+void * Arena::allocate(const std::size_t bytes, const std::size_t alignment){
+    std::size_t pad = (alignment - (reinterpret_cast <std::size_t> (pos) % alignment)) % alignment;
+    if (!pos || ((pad + bytes) > left)){
+        // oversized requests get a chunk of their own
+        const std::size_t size = std::max(chunk_size, bytes + alignment);
+        chunks.push_back(static_cast <char *> (::operator new(size)));
+        pos = chunks.back();
+        left = size;
+        reserved += size;
+        pad = (alignment - (reinterpret_cast <std::size_t> (pos) % alignment)) % alignment;
+    }
+
+    void * out = pos + pad;
+    pos += pad + bytes;
+    left -= pad + bytes;
+    used += bytes;
+    return out;
+}
+
+std::size_t Arena::get_used() const{
+    return used;
+}
+
+std::size_t Arena::get_reserved() const{
+    return reserved;
+}
+
+Arena::Ptr Arena::current(){
+    return current_arena;
+}
+
+}
@@ -0,0 +1,126 @@
+/*
+Arena.h
+Monotonic arena for objects that are created together and released together
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ARENA__
+#define __ARENA__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace OpenPGP {
+    // Allocations are carved sequentially out of large chunks and are never
+    // returned individually; every chunk is freed when the arena is destroyed.
+    // Not thread safe: only allocate from one thread at a time.
+    class Arena {
+        public:
+            typedef std::shared_ptr <Arena> Ptr;
+
+            static const std::size_t DEFAULT_CHUNK = 1 << 16;
+
+            // makes allocations on the current thread come from an arena
+            // until the scope ends; a null arena leaves the current one in place
+            class Scope {
+                private:
+                    Arena::Ptr previous;
+                    bool active;
+
+                public:
+                    Scope(const Arena::Ptr & arena);
+                    ~Scope();
+
+                    Scope(const Scope &) = delete;
+                    Scope & operator=(const Scope &) = delete;
+            };
+
+        private:
+            std::vector <char *> chunks;
+            std::size_t chunk_size;
+            char * pos;
+            std::size_t left;
+            std::size_t used;
+            std::size_t reserved;
+
+        public:
+            Arena(const std::size_t chunk = DEFAULT_CHUNK);
+            ~Arena();
+
+            Arena(const Arena &) = delete;
+            Arena & operator=(const Arena &) = delete;
+
+            void * allocate(const std::size_t bytes, const std::size_t alignment = alignof(std::max_align_t));
+
+            std::size_t get_used() const;           // octets handed out
+            std::size_t get_reserved() const;       // octets held in chunks
+
+            static Ptr current();                   // arena of the innermost Scope on this thread, or null
+    };
+
+    // Allocator for std::allocate_shared; every copy keeps the arena alive,
+    // so the arena is freed once the last object allocated from it is gone
+    template <typename T>
+    class ArenaAllocator {
+        public:
+            typedef T value_type;
+
+            Arena::Ptr arena;
+
+            ArenaAllocator(const Arena::Ptr & a)
+                : arena(a)
+            {}
+
+            template <typename U> ArenaAllocator(const ArenaAllocator <U> & copy)
+                : arena(copy.arena)
+            {}
+
+            T * allocate(const std::size_t n){
+                return static_cast <T *> (arena -> allocate(n * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T *, const std::size_t){}
+    };
+
+    template <typename T, typename U>
+    bool operator==(const ArenaAllocator <T> & a, const ArenaAllocator <U> & b){
+        return a.arena == b.arena;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const ArenaAllocator <T> & a, const ArenaAllocator <U> & b){
+        return a.arena != b.arena;
+    }
+
+    // create a shared object in the current arena, or with std::make_shared if there is none;
+    // either way the object and its control block are a single allocation
+    template <typename T, typename... Args>
+    std::shared_ptr <T> arena_make_shared(Args &&... args){
+        if (const Arena::Ptr arena = Arena::current()){
+            return std::allocate_shared <T> (ArenaAllocator <T> (arena), std::forward <Args> (args)...);
+        }
+        return std::make_shared <T> (std::forward <Args> (args)...);
+    }
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "Buffer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BUFFER_MMAP_SUPPORTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace OpenPGP {
+
+namespace {
+
+class StringBuffer : public Buffer {
+    private:
+        const std::string str;
+
+    public:
+        StringBuffer(std::string s)
+            : str(std::move(s))
+        {}
+
+        const char * data() const{
+            return str.data();
+        }
+
+        std::size_t size() const{
+            return str.size();
+        }
+};
+
+#ifdef BUFFER_MMAP_SUPPORTED
+class MappedBuffer : public Buffer {
+    private:
+        void * addr;
+        std::size_t len;
+
+    public:
+        MappedBuffer(const std::string & filename)
+            : addr(nullptr),
+              len(0)
+        {
+            const int fd = open(filename.c_str(), O_RDONLY);
+            if (fd < 0){
+                throw std::runtime_error("Error: File \"" + filename + "\" not opened.");
+            }
+
+            struct stat st;
+            if (fstat(fd, &st) < 0){
+                close(fd);
+                throw std::runtime_error("Error: Could not get size of \"" + filename + "\".");
+            }
+
+            len = st.st_size;
+            if (len){
+                addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            close(fd);
+
+            if (addr == MAP_FAILED){
+                throw std::runtime_error("Error: Could not map \"" + filename + "\".");
+            }
+        }
+
+        ~MappedBuffer(){
+            if (addr){
+                munmap(addr, len);
+            }
+        }
+
+        const char * data() const{
+            return static_cast <const char *> (addr);
+        }
+
+        std::size_t size() const{
+            return len;
+        }
+};
+#endif
+
+}
+
+Buffer::~Buffer(){}
+
+Buffer::Ptr Buffer::own(std::string str){
+    return std::make_shared <StringBuffer> (std::move(str));
+}
+
+Buffer::Ptr Buffer::map(const std::string & filename){
+    #ifdef BUFFER_MMAP_SUPPORTED
+    return std::make_shared <MappedBuffer> (filename);
+    #else
+    std::ifstream f(filename, std::ios::binary);
+    if (!f){
+        throw std::runtime_error("Error: File \"" + filename + "\" not opened.");
+    }
+    return own(std::string(std::istreambuf_iterator <char> (f), {}));
+    #endif
+}
+
+const std::size_t Slice::npos;
+
+Slice::Slice()
+    : buffer(),
+      offset(0),
+      length(0)
+{}
+
+Slice::Slice(const Buffer::Ptr & buf, const std::size_t pos, const std::size_t len)
+    : buffer(buf),
+      offset(0),
+      length(0)
+{
+    const std::size_t size = buffer?buffer -> size():0;
+    if (pos > size){
+        throw std::out_of_range("Error: Slice position out of range.");
+    }
+    offset = pos;
+    length = std::min(len, size - pos);
+}
+
+Slice::Slice(const std::string & str)
+    : Slice(Buffer::own(str))
+{}
+
+const char * Slice::data() const{
+    return buffer?(buffer -> data() + offset):nullptr;
+}
+
+std::size_t Slice::size() const{
+    return length;
+}
+
+bool Slice::empty() const{
+    return !length;
+}
+
+char Slice::operator[](const std::size_t i) const{
+    if (i >= length){
+        throw std::out_of_range("Error: Slice index out of range.");
+    }
+    return data()[i];
+}
+
+Slice Slice::slice(std::size_t pos, std::size_t len) const{
+    if (pos > length){
+        throw std::out_of_range("Error: Slice position out of range.");
+    }
+    return Slice(buffer, offset + pos, std::min(len, length - pos));
+}
+
+std::string Slice::substr(std::size_t pos, std::size_t len) const{
+    if (pos > length){
+        throw std::out_of_range("Error: Slice position out of range.");
+    }
+    return std::string(data() + pos, std::min(len, length - pos));
+}
+
+std::string Slice::str() const{
+    return std::string(data(), length);
+}
+
+SliceBuf::SliceBuf(const Slice & s)
+    : std::streambuf(),
+      slice(s)
+{
+    char * begin = const_cast <char *> (slice.data());     // only ever read
+    setg(begin, begin, begin + slice.size());
+}
+
+SliceBuf::pos_type SliceBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which){
+    if (!(which & std::ios_base::in)){
+        return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+    if (dir == std::ios_base::cur){
+        base = gptr() - eback();
+    }
+    else if (dir == std::ios_base::end){
+        base = egptr() - eback();
+    }
+
+    const off_type pos = base + off;
+    if ((pos < 0) || (pos > (egptr() - eback()))){
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + pos, egptr());
+    return pos_type(pos);
+}
+
+SliceBuf::pos_type SliceBuf::seekpos(pos_type pos, std::ios_base::openmode which){
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+}
@@ -0,0 +1,92 @@
+/*
+Buffer.h
+Immutable, shared octet buffers and non-owning slices into them,
+used to parse packets without copying their bodies
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __BUFFER__
+#define __BUFFER__
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+namespace OpenPGP {
+    // octets that do not change once created
+    class Buffer {
+        public:
+            typedef std::shared_ptr <const Buffer> Ptr;
+
+            virtual ~Buffer();
+
+            virtual const char * data() const = 0;
+            virtual std::size_t size() const = 0;
+
+            // take ownership of a string
+            static Ptr own(std::string str);
+
+            // map a file into memory (read only); falls back to reading the file where mmap is unavailable
+            static Ptr map(const std::string & filename);
+    };
+
+    // window into a Buffer; keeps the Buffer alive, but does not copy it
+    class Slice {
+        private:
+            Buffer::Ptr buffer;
+            std::size_t offset;
+            std::size_t length;
+
+        public:
+            static const std::size_t npos = std::string::npos;
+
+            Slice();
+            Slice(const Buffer::Ptr & buf, const std::size_t pos = 0, const std::size_t len = npos);
+            Slice(const std::string & str);     // copies str into a new Buffer
+
+            const char * data() const;
+            std::size_t size() const;
+            bool empty() const;
+            char operator[](const std::size_t i) const;     // throws std::out_of_range past the end
+
+            Slice slice(std::size_t pos, std::size_t len = npos) const;     // no copy
+            std::string substr(std::size_t pos, std::size_t len = npos) const;
+            std::string str() const;
+    };
+
+    // read a Slice as a stream without copying it
+    class SliceBuf : public std::streambuf {
+        private:
+            Slice slice;
+
+        protected:
+            pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in);
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in);
+
+        public:
+            SliceBuf(const Slice & s);
+    };
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "CPU.h"
+
+#include <cstdint>
+
+#ifdef CPU_X86
+#include <cpuid.h>
+#endif
+
+namespace OpenPGP {
+namespace CPU {
+
+namespace {
+
+struct Features{
+    bool ssse3;
+    bool sse41;
+    bool pclmul;
+    bool aes;
+    bool avx2;
+    bool sha;
+
+    Features()
+        : ssse3(false),
+          sse41(false),
+          pclmul(false),
+          aes(false),
+          avx2(false),
+          sha(false)
+    {
+#ifdef CPU_X86
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)){
+            return;
+        }
+
+        ssse3  = ecx & bit_SSSE3;
+        sse41  = ecx & bit_SSE4_1;
+        pclmul = ecx & bit_PCLMUL;
+        aes    = ecx & bit_AES;
+
+        // the OS has to save the YMM registers for AVX to be usable
+        bool ymm = false;
+        if ((ecx & bit_AVX) && (ecx & bit_OSXSAVE)){
+            uint32_t lo, hi;
+            __asm__ __volatile__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            ymm = ((lo & 6) == 6);
+        }
+
+        if (__get_cpuid_max(0, nullptr) < 7){
+            return;
+        }
+
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        avx2 = ymm && (ebx & bit_AVX2);
+        sha  = ebx & (1U << 29);    // not every <cpuid.h> defines bit_SHA
+#endif
+    }
+};
+
+const Features & features(){
+    static const Features features;
+    return features;
+}
+
+}
+
+bool ssse3(){
+    return features().ssse3;
+}
+
+bool sse41(){
+    return features().sse41;
+}
+
+bool pclmul(){
+    return features().pclmul;
+}
+
+bool aes(){
+    return features().aes;
+}
+
+bool avx2(){
+    return features().avx2;
+}
+
+bool sha(){
+    return features().sha;
+}
+
+}
+}
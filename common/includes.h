@@ -73,6 +73,38 @@ template <typename T> uint8_t byte(const T & value, const uint16_t & n){
     return (value >> (n << 3)) & 0xff;
 }
 
+// read a big endian value from an octet buffer
+template <typename T> T load_big_endian(const uint8_t * in){
+    T value = 0;
+    for(std::size_t i = 0; i < sizeof(T); i++){
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+// write a value into an octet buffer in big endian order
+template <typename T> void store_big_endian(const T value, uint8_t * out){
+    for(std::size_t i = 0; i < sizeof(T); i++){
+        out[i] = byte(value, sizeof(T) - 1 - i);
+    }
+}
+
+// read a little endian value from an octet buffer
+template <typename T> T load_little_endian(const uint8_t * in){
+    T value = 0;
+    for(std::size_t i = sizeof(T); i > 0; i--){
+        value = (value << 8) | in[i - 1];
+    }
+    return value;
+}
+
+// write a value into an octet buffer in little endian order
+template <typename T> void store_little_endian(const T value, uint8_t * out){
+    for(std::size_t i = 0; i < sizeof(T); i++){
+        out[i] = byte(value, i);
+    }
+}
+
 // direct binary to hex string
 std::string bintohex(const std::string & in, bool caps = false);
 
@@ -1 +1,4 @@
-COMMON_OBJECTS=includes.o
\ No newline at end of file
+COMMON_OBJECTS=Arena.o    \
+               CPU.o      \
+               Buffer.o   \
+               includes.o
\ No newline at end of file
@@ -1,11 +1,14 @@
 #include "decrypt.h"
 
+#include <algorithm>
+
 namespace OpenPGP {
 namespace Decrypt {
 
 Message data(const uint8_t sym,
              const Message & message,
-             const std::string & session_key){
+             const std::string & session_key,
+             const unsigned int threads){
     if (!message.meaningful()){
         // "Error: Bad message.\n";
         return Message();
@@ -41,25 +44,45 @@ Message data(const uint8_t sym,
         return Message();
     }
 
-    // decrypt data
-    data = use_OpenPGP_CFB_decrypt(sym, tag, data, session_key);
-
     // get blocksize of symmetric key algorithm
     const unsigned int BS = Sym::BLOCK_LENGTH.at(sym) >> 3;
 
-    // strip extra data
     if (tag == Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA){
-        const std::string checksum = data.substr(data.size() - 20, 20); // get given SHA1 checksum
-        data = data.substr(0, data.size() - 20);                        // remove SHA1 checksum
-        if (Hash::use(Hash::ID::SHA1, data) != checksum){                    // check SHA1 checksum
+        // prefix, data and the 22 octet MDC packet
+        if (data.size() < (BS + 2 + 22)){
+            // "Error: Encrypted data too short.";
+            return Message();
+        }
+
+        SHA1 mdc;
+        if ((threads != 1) && ((data.size() - BS - 2) >= CFB_PARALLEL_THRESHOLD)){
+            // split the body across threads, then hash everything before the SHA1 checksum
+            data = OpenPGP_CFB_decrypt(Sym::setup(sym, session_key), tag, data, threads);
+            mdc.update(reinterpret_cast <const uint8_t *> (data.data()), data.size() - 20);
+        }
+        else{
+            // hash the plaintext while it is still in cache, stopping before the SHA1 checksum
+            std::size_t to_hash = data.size() - 20;
+            data = OpenPGP_CFB_decrypt(Sym::setup(sym, session_key), tag, data,
+                                       [&mdc, &to_hash](const uint8_t * plain, const std::size_t len){
+                                           const std::size_t n = std::min(len, to_hash);
+                                           mdc.update(plain, n);
+                                           to_hash -= n;
+                                       });
+        }
+
+        if ((data.compare(data.size() - 22, 2, "\xd3\x14") != 0) ||              // check MDC packet header
+            (data.compare(data.size() - 20, 20, mdc.digest()) != 0)){          // check SHA1 checksum
             // "Error: Given checksum and calculated checksum do not match.";
             return Message();
         }
 
-        data = data.substr(0, data.size() - 2);                         // get rid of \xd3\x14
+        data = data.substr(BS + 2, data.size() - BS - 2 - 22);          // get rid of prefix and MDC
+    }
+    else{
+        data = use_OpenPGP_CFB_decrypt(sym, tag, data, session_key, threads);
+        data = data.substr(BS + 2, data.size() - BS - 2);               // get rid of prefix
     }
-
-    data = data.substr(BS + 2, data.size() - BS - 2);                   // get rid of prefix
 
     // decompress and parse decrypted data
     return Message(data);
@@ -67,7 +90,8 @@ Message data(const uint8_t sym,
 
 Message pka(const SecretKey & pri,
             const std::string & passphrase,
-            const Message & message){
+            const Message & message,
+            const unsigned int threads){
     if (!pri.meaningful()){
         // "Error: Bad private key.\n";
         return Message();
@@ -154,11 +178,12 @@ Message pka(const SecretKey & pri,
     }
 
     // decrypt the data with the extracted key
-    return data(sym, message, symkey);
+    return data(sym, message, symkey, threads);
 }
 
 Message sym(const Message & message,
-            const std::string & passphrase){
+            const std::string & passphrase,
+            const unsigned int threads){
     if (!message.meaningful()){
         // "Error: Bad message.\n";
         return Message();
@@ -180,7 +205,7 @@ Message sym(const Message & message,
     }
 
     const std::string symkey = tag3 -> get_session_key(passphrase);
-    return data(symkey[0], message, symkey.substr(1, symkey.size() - 1));
+    return data(symkey[0], message, symkey.substr(1, symkey.size() - 1), threads);
 }
 
 }
@@ -43,19 +43,23 @@ THE SOFTWARE.
 namespace OpenPGP {
     namespace Decrypt {
         // decrypt data once session key is known
+        // threads is passed on to OpenPGP_CFB_decrypt; 0 uses all hardware threads
         Message data(const uint8_t sym,
                      const Message & message,
-                     const std::string & session_key);
+                     const std::string & session_key,
+                     const unsigned int threads = 1);
 
         // called from outside
         // session key encrypted with public key algorithm
         Message pka(const SecretKey & pri,
                     const std::string & passphrase,
-                    const Message & message);
+                    const Message & message,
+                    const unsigned int threads = 1);
 
         // session key encrypted with symmetric algorithm
         Message sym(const Message & message,
-                    const std::string & passphrase);
+                    const std::string & passphrase,
+                    const unsigned int threads = 1);
 
 }
 }
@@ -48,23 +48,37 @@ Packet::Tag::Ptr data(const Args & args,
     std::string prefix = unbinify(RNG::BBS().rand(BS));
     prefix += prefix.substr(prefix.size() - 2, 2);
 
+    // prefix and data are encrypted in place in a single buffer
+    std::string buf;
+    buf.reserve(prefix.size() + to_encrypt.size() + 22);
+    buf = prefix;
+    buf += to_encrypt;
+
+    const SymAlg::Ptr alg = Sym::setup(args.sym, session_key);
     Packet::Tag::Ptr encrypted = nullptr;
 
     if (!args.mdc){
         // Symmetrically Encrypted Data Packet (Tag 9)
+        OpenPGP_CFB_encrypt_in_place(alg, Packet::SYMMETRICALLY_ENCRYPTED_DATA, buf);
+
         Packet::Tag9 tag9;
-        tag9.set_encrypted_data(use_OpenPGP_CFB_encrypt(args.sym, Packet::SYMMETRICALLY_ENCRYPTED_DATA, to_encrypt, session_key, prefix));
+        tag9.set_encrypted_data(buf);
         encrypted = std::make_shared <Packet::Tag9> (tag9);
     }
     else{
         // Modification Detection Code Packet (Tag 19)
         Packet::Tag19 tag19;
-        tag19.set_hash(Hash::use(Hash::ID::SHA1, prefix + to_encrypt + "\xd3\x14"));
+        SHA1 mdc(buf);
+        mdc.update("\xd3\x14");
+        tag19.set_hash(mdc.digest());
+        buf += tag19.write();
 
         // Sym. Encrypted Integrity Protected Data Packet (Tag 18)
         // encrypt(compressed(literal_data_packet(plain text)) + MDC SHA1(20 octets))
+        OpenPGP_CFB_encrypt_in_place(alg, Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA, buf);
+
         Packet::Tag18 tag18;
-        tag18.set_protected_data(use_OpenPGP_CFB_encrypt(args.sym, Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA, to_encrypt + tag19.write(), session_key, prefix));
+        tag18.set_protected_data(buf);
         encrypted = std::make_shared <Packet::Tag18> (tag18);
     }
 
@@ -174,7 +188,7 @@ Message sym(const Args & args,
     s2k -> set_type(S2K::ID::ITERATED_AND_SALTED_S2K);
     s2k -> set_hash(key_hash);
     s2k -> set_salt(unbinify(RNG::BBS().rand(64)));
-    s2k -> set_count(96);
+    s2k -> set_count(args.s2k_count);
 
     // generate Symmetric-Key Encrypted Session Key Packets (Tag 3)
     Packet::Tag3::Ptr tag3 = std::make_shared <Packet::Tag3> ();
@@ -51,6 +51,7 @@ namespace OpenPGP {
             SecretKey::Ptr signer;          // for signing data
             std::string passphrase;         // only used when signer is present
             uint8_t hash;                   // hash used to sign data
+            uint8_t s2k_count;              // coded S2K count for passphrase encryption; see S2K::S2K3::calibrate
 
             Args(const std::string & fname = "",
                  const std::string & dat = "",
@@ -59,7 +60,8 @@ namespace OpenPGP {
                  const bool mod_detect = true,
                  const SecretKey::Ptr & signing_key = nullptr,
                  const std::string & pass = "",
-                 const uint8_t hash_alg = Hash::ID::SHA1)
+                 const uint8_t hash_alg = Hash::ID::SHA1,
+                 const uint8_t count = 96)
                 : filename(fname),
                   data(dat),
                   sym(sym_alg),
@@ -67,7 +69,8 @@ namespace OpenPGP {
                   mdc(mod_detect),
                   signer(signing_key),
                   passphrase(pass),
-                  hash(hash_alg)
+                  hash(hash_alg),
+                  s2k_count(count)
             {}
 
             bool valid() const{
@@ -0,0 +1,80 @@
+/*
+calibrate_s2k.h
+OpenPGP exectuable module
+
+Copyright (c) 2013 - 2018 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __COMMAND_CALIBRATE_S2K__
+#define __COMMAND_CALIBRATE_S2K__
+
+#include <chrono>
+#include <cstdlib>
+
+#include "../../OpenPGP.h"
+#include "module.h"
+
+namespace module {
+
+const Module calibrate_s2k(
+    // name
+    "calibrate-s2k",
+
+    // positional arguments
+    {
+
+    },
+
+    // optional arguments
+    {
+        std::make_pair("--ms", std::make_pair("target unlock time in milliseconds", "100")),
+    },
+
+    // optional flags
+    {
+
+    },
+
+    // function to run
+    [](const std::map <std::string, std::string> & args,
+       const std::map <std::string, bool>        & flags,
+       std::ostream                              & out,
+       std::ostream                              & err) -> int {
+        unsigned long ms = 0;
+        if (!to_ulong(args.at("--ms"), ms) || !ms){
+            err << "Error: Bad target time: " << args.at("--ms") << std::endl;
+            return -1;
+        }
+
+        // coded count to use with each hash on this machine
+        for(std::pair <const uint8_t, std::size_t> const & hash : OpenPGP::Hash::LENGTH){
+            const uint8_t count = OpenPGP::S2K::S2K3::calibrate(hash.first, std::chrono::milliseconds(ms));
+            out << OpenPGP::Hash::NAME.at(hash.first) << ": " << std::to_string(count)
+                << " (" << OpenPGP::S2K::S2K3::coded_count(count) << " octets)" << std::endl;
+        }
+
+        return 0;
+    }
+);
+
+}
+
+#endif
@@ -120,7 +120,8 @@ const Module encrypt_pka(
             return -1;
         }
 
-        out << encrypted.write(flags.at("-a")?OpenPGP::PGP::Armored::YES:OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW) << std::endl;
+        encrypted.write(out, flags.at("-a")?OpenPGP::PGP::Armored::YES:OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW);
+        out << std::endl;
         return 0;
     }
 );
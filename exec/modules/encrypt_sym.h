@@ -26,6 +26,9 @@ THE SOFTWARE.
 #ifndef __COMMAND_ENCRYPT_SYM__
 #define __COMMAND_ENCRYPT_SYM__
 
+#include <chrono>
+#include <cstdlib>
+
 #include "../../OpenPGP.h"
 #include "module.h"
 
@@ -49,6 +52,8 @@ const Module encrypt_sym(
         std::make_pair("--khash",   std::make_pair("hash algorithm for key generation",             "SHA1")),
         std::make_pair("--sign",    std::make_pair("private key file",                                  "")),
         std::make_pair("--shash",   std::make_pair("hash algorithm for signing",                    "SHA1")),
+        std::make_pair("--count",   std::make_pair("coded S2K count (0 - 255) or \"auto\"",         "96")),
+        std::make_pair("--ms",      std::make_pair("target unlock time in ms for --count auto",      "100")),
     },
 
     // optional flags
@@ -88,6 +93,24 @@ const Module encrypt_sym(
             return -1;
         }
 
+        uint8_t count = 96;
+        if (args.at("--count") == "auto"){
+            unsigned long ms = 0;
+            if (!to_ulong(args.at("--ms"), ms) || !ms){
+                err << "Error: Bad target time: " << args.at("--ms") << std::endl;
+                return -1;
+            }
+            count = OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::NUMBER.at(args.at("--khash")), std::chrono::milliseconds(ms));
+        }
+        else{
+            unsigned long c = 0;
+            if (!to_ulong(args.at("--count"), c) || (c > 255)){
+                err << "Error: Bad S2K count: " << args.at("--count") << std::endl;
+                return -1;
+            }
+            count = c;
+        }
+
         OpenPGP::SecretKey::Ptr signer = nullptr;
         if (args.at("--sign").size()){
             std::ifstream signing(args.at("--sign"), std::ios::binary);
@@ -111,9 +134,11 @@ const Module encrypt_sym(
                                                  flags.at("--mdc"),
                                                  signer,
                                                  args.at("-p"),
-                                                 OpenPGP::Hash::NUMBER.at(args.at("--shash")));
+                                                 OpenPGP::Hash::NUMBER.at(args.at("--shash")),
+                                                 count);
 
-        out << OpenPGP::Encrypt::sym(encryptargs, args.at("passphrase"), OpenPGP::Hash::NUMBER.at(args.at("--khash"))).write(flags.at("-a")?OpenPGP::PGP::Armored::YES:OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW) << std::endl;
+        OpenPGP::Encrypt::sym(encryptargs, args.at("passphrase"), OpenPGP::Hash::NUMBER.at(args.at("--khash"))).write(out, flags.at("-a")?OpenPGP::PGP::Armored::YES:OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW);
+        out << std::endl;
         return 0;
     }
 );
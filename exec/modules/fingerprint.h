@@ -69,7 +69,10 @@ const Module fingerprint(
             return -1;
         }
 
-        const OpenPGP::Key key(f);
+        // signatures are not needed, so leave them undecoded
+        OpenPGP::Key key;
+        key.set_lazy(true);
+        key.read(f);
 
         if (!key.meaningful()){
             err << "Error: Key is not meaningful." << std::endl;
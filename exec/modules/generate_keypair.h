@@ -26,6 +26,8 @@ THE SOFTWARE.
 #ifndef __COMMAND_GENERATE_KEYPAIR__
 #define __COMMAND_GENERATE_KEYPAIR__
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 
@@ -62,6 +64,9 @@ const Module generate_keypair(
         std::make_pair("--ssym",     std::make_pair("Subkey S2K Symmetric Key Algorithm",                "AES256")),
         std::make_pair("--shash",    std::make_pair("Subkey S2K Hash Algorithm",                           "SHA1")),
         std::make_pair("--ssig",     std::make_pair("Subkey Signature Hash Algorithm",                     "SHA1")),
+
+        std::make_pair("--count",    std::make_pair("coded S2K count (0 - 255) or \"auto\"",                "96")),
+        std::make_pair("--ms",       std::make_pair("target unlock time in ms for --count auto",             "100")),
     },
 
     // optional flags
@@ -121,6 +126,27 @@ const Module generate_keypair(
         config.sym        = OpenPGP::Sym::NUMBER.at(args.at("--psym"));
         config.hash       = OpenPGP::Hash::NUMBER.at(args.at("--phash"));
 
+        if (args.at("--count") == "auto"){
+            unsigned long target = 0;
+            if (!to_ulong(args.at("--ms"), target) || !target){
+                err << "Error: Bad target time: " << args.at("--ms") << std::endl;
+                return -1;
+            }
+
+            // subkeys use the same count; the larger one reaches the target with both hashes
+            const std::chrono::milliseconds ms(target);
+            config.s2k_count  = std::max(OpenPGP::S2K::S2K3::calibrate(config.hash, ms),
+                                         OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::NUMBER.at(args.at("--shash")), ms));
+        }
+        else{
+            unsigned long c = 0;
+            if (!to_ulong(args.at("--count"), c) || (c > 255)){
+                err << "Error: Bad S2K count: " << args.at("--count") << std::endl;
+                return -1;
+            }
+            config.s2k_count  = c;
+        }
+
         OpenPGP::KeyGen::Config::UserID uid;
         uid.user          = args.at("-u");
         uid.comment       = args.at("-c");
@@ -1,5 +1,10 @@
 #include "module.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
 namespace module {
 
 void Module::check_names_ws() const{
@@ -217,4 +222,16 @@ int Module::operator()(int argc, char * argv[], std::ostream & out, std::ostream
     return 0;
 }
 
+bool to_ulong(const std::string & str, unsigned long & value){
+    // strtoul skips whitespace and accepts signs, so require digits only
+    if (str.empty() || !std::all_of(str.begin(), str.end(), [](const char c){ return std::isdigit(static_cast <unsigned char> (c)); })){
+        return false;
+    }
+
+    char * end = nullptr;
+    errno = 0;
+    value = std::strtoul(str.c_str(), &end, 10);
+    return !errno && (*end == '\0');
+}
+
 }
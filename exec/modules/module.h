@@ -93,6 +93,9 @@ class Module{
                        std::ostream & err = std::cerr) const;
 };
 
+// parse a whole string as a non-negative decimal number; false on empty, non-numeric or out of range input
+bool to_ulong(const std::string & str, unsigned long & value);
+
 }
 
 #endif
@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "encrypt_sym.h"
 #include "decrypt_pka.h"
 #include "decrypt_sym.h"
+#include "calibrate_s2k.h"
 #include "generate_keypair.h"
 #include "generate_revoke_key_cert.h"
 #include "generate_revoke_subkey_cert.h"
@@ -72,6 +73,7 @@ const std::vector <Module> ordered = {
     encrypt_sym,
     decrypt_pka,
     decrypt_sym,
+    calibrate_s2k,
     generate_keypair,
     generate_revoke_key_cert,
     generate_revoke_subkey_cert,
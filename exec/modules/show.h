@@ -61,7 +61,20 @@ const Module show(
             return -1;
         }
 
-        out << OpenPGP::PGP(file).show() << std::flush;
+        // binary data is shown one packet at a time; unlike PGP::show, a
+        // packet with Partial Body Lengths is shown once with its whole body
+        const int first = file.peek();
+        if ((first != EOF) && (first & 0x80)){
+            OpenPGP::PacketReader reader(file);
+            OpenPGP::PacketReader::Header header;
+            while (reader.next(header)){
+                out << reader.packet() -> show() << "\n";
+            }
+            out << std::flush;
+        }
+        else{
+            out << OpenPGP::PGP(file).show() << std::flush;
+        }
         return 0;
     }
 );
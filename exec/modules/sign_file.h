@@ -92,7 +92,8 @@ const Module sign_file(
             return -1;
         }
 
-        out << message.write(flags.at("-a")?OpenPGP::PGP::Armored::YES:OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW) << std::endl;
+        message.write(out, flags.at("-a")?OpenPGP::PGP::Armored::YES:OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW);
+        out << std::endl;
         return 0;
     }
 );
@@ -125,7 +125,7 @@ SecretKey generate_key(Config & config){
         S2K::S2K3::Ptr s2k3 = std::make_shared <S2K::S2K3> ();
         s2k3 -> set_hash(config.hash);
         s2k3 -> set_salt(unhexlify(bintohex(RNG::BBS().rand(64))));
-        s2k3 -> set_count(96);
+        s2k3 -> set_count(config.s2k_count);
 
         // calculate the key from the passphrase
         const std::string session_key = s2k3 -> run(config.passphrase, Sym::KEY_LENGTH.at(config.sym) >> 3);
@@ -222,7 +222,7 @@ SecretKey generate_key(Config & config){
             S2K::S2K3::Ptr s2k3 = std::make_shared <S2K::S2K3> ();
             s2k3 -> set_hash(skey.hash);
             s2k3 -> set_salt(unhexlify(bintohex(RNG::BBS().rand(64)))); // new salt value
-            s2k3 -> set_count(96);
+            s2k3 -> set_count(config.s2k_count);
 
             // calculate the key from the passphrase
             std::string session_key = s2k3 -> run(config.passphrase, Sym::KEY_LENGTH.at(skey.sym) >> 3);
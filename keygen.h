@@ -54,6 +54,7 @@ namespace OpenPGP {
             std::size_t bits        = 2048;
             uint8_t     sym         = Sym::ID::AES256;          // symmetric key algorithm used by S2K
             uint8_t     hash        = Hash::ID::SHA256;         // hash algorithm used by S2K
+            uint8_t     s2k_count   = 96;                       // coded S2K count for all keys; see S2K::S2K3::calibrate
 
             // User ID (s)
             struct UserID{
@@ -6,6 +6,7 @@ OPENPGP_OBJECTS=CleartextSignature.o        \
                 Key.o                       \
                 keygen.o                    \
                 Message.o                   \
+                PacketReader.o              \
                 RevocationCertificate.o     \
                 revoke.o                    \
                 sign.o                      \
@@ -65,3 +65,75 @@ TEST(AES, 256_varkey) {
 TEST(AES, 256_vartxt) {
     sym_test <AES> (AES256_VARTXT);
 }
+
+// run every key size through each implementation explicitly
+static void aes_test(const AES::Implementation impl){
+    for(std::vector <PlainKeyCipher> const & vectors : {AES128_GFSBOX, AES128_SBOX, AES128_VARKEY, AES128_VARTXT,
+                                                        AES192_GFSBOX, AES192_SBOX, AES192_VARKEY, AES192_VARTXT,
+                                                        AES256_GFSBOX, AES256_SBOX, AES256_VARKEY, AES256_VARTXT}){
+        sym_test <AES> (vectors, impl);
+    }
+}
+
+TEST(AES, portable) {
+    aes_test(AES::PORTABLE);
+}
+
+TEST(AES, aesni) {
+    if (!AESNI::available()){
+        return;
+    }
+
+    aes_test(AES::AESNI);
+    EXPECT_EQ(AES(std::string(16, 0)).implementation(), AES::AESNI);
+}
+
+TEST(AES, aesni_multiblock) {
+    if (!AESNI::available()){
+        return;
+    }
+
+    // exercise the 4-way interleaved path and the tail against the portable code
+    const std::string key = unhexlify("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    AES portable(key, AES::PORTABLE);
+    AES ni(key, AES::AESNI);
+
+    std::string plain(16 * 7, 0);
+    for(std::size_t i = 0; i < plain.size(); i++){
+        plain[i] = static_cast <char> (i * 7 + 3);
+    }
+
+    std::string expected = plain;
+    std::string buf = plain;
+    portable.encrypt_blocks(reinterpret_cast <uint8_t *> (&expected[0]), 7);
+    ni.encrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 7);
+    EXPECT_EQ(buf, expected);
+
+    ni.decrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 7);
+    EXPECT_EQ(buf, plain);
+}
+
+TEST(AES, bitsliced) {
+    aes_test(AES::BITSLICED);
+}
+
+TEST(AES, bitsliced_multiblock) {
+    // two full groups of 8 and a partial group
+    const std::string key = unhexlify("000102030405060708090a0b0c0d0e0f1011121314151617");
+    AES portable(key, AES::PORTABLE);
+    AES bitsliced(key, AES::BITSLICED);
+
+    std::string plain(16 * 19, 0);
+    for(std::size_t i = 0; i < plain.size(); i++){
+        plain[i] = static_cast <char> (i * 13 + 5);
+    }
+
+    std::string expected = plain;
+    std::string buf = plain;
+    portable.encrypt_blocks(reinterpret_cast <uint8_t *> (&expected[0]), 19);
+    bitsliced.encrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 19);
+    EXPECT_EQ(buf, expected);
+
+    bitsliced.decrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 19);
+    EXPECT_EQ(buf, plain);
+}
@@ -38,14 +38,22 @@ THE SOFTWARE.
 typedef std::tuple <std::string, std::string, std::string> PlainKeyCipher;
 
 // generic function to test symmetric key algorithms
-template <typename Alg>
-void sym_test(const std::vector <PlainKeyCipher> & test_vectors){
+// any extra arguments are passed to the constructor after the key
+template <typename Alg, typename... Args>
+void sym_test(const std::vector <PlainKeyCipher> & test_vectors, Args... args){
     for(PlainKeyCipher const & pkc : test_vectors){
         std::string plain, key, cipher;
         std::tie(plain, key, cipher) = pkc;
-        auto alg = Alg(unhexlify(key));
+        auto alg = Alg(unhexlify(key), args...);
         EXPECT_EQ(alg.encrypt(unhexlify(plain)), unhexlify(cipher));
         EXPECT_EQ(alg.decrypt(unhexlify(cipher)), unhexlify(plain));
+
+        // multiple blocks at once, in place
+        std::string buf = unhexlify(plain + plain + plain);
+        alg.encrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 3);
+        EXPECT_EQ(buf, unhexlify(cipher + cipher + cipher));
+        alg.decrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 3);
+        EXPECT_EQ(buf, unhexlify(plain + plain + plain));
     }
 }
 
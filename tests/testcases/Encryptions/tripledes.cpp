@@ -62,3 +62,22 @@ TEST(TripleDES, vartext) {
         EXPECT_EQ(tdes.decrypt(unhexlify(cipher)), unhexlify(plain));
     }
 }
+
+TEST(TripleDES, blocks) {
+    const std::string key1 = unhexlify("0123456789abcdef");
+    const std::string key2 = unhexlify("23456789abcdef01");
+    const std::string key3 = unhexlify("456789abcdef0123");
+    auto tdes = TDES(key1, "e", key2, "d", key3, "e");
+
+    const std::string plain = unhexlify("4e6f772069732074"
+                                        "68652074696d6520"
+                                        "666f7220616c6c20");
+    std::string buf = plain;
+    tdes.encrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 3);
+    for(std::size_t i = 0; i < 3; i++){
+        EXPECT_EQ(buf.substr(i << 3, 8), tdes.encrypt(plain.substr(i << 3, 8)));
+        EXPECT_EQ(tdes.decrypt(buf.substr(i << 3, 8)), plain.substr(i << 3, 8));
+    }
+    tdes.decrypt_blocks(reinterpret_cast <uint8_t *> (&buf[0]), 3);
+    EXPECT_EQ(buf, plain);
+}
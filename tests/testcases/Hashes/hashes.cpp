@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "Hashes/Hashes.h"
+
+TEST(Hash, create) {
+    for(std::pair <const uint8_t, std::size_t> const & length : OpenPGP::Hash::LENGTH){
+        MerkleDamgard::Ptr hash = OpenPGP::Hash::create(length.first);
+        ASSERT_TRUE(static_cast <bool> (hash));
+        EXPECT_EQ(hash -> digestsize(), length.second);
+
+        // pieces give the same result as the whole message
+        hash -> update("The quick brown fox ");
+        hash -> update("jumps over the lazy dog");
+        EXPECT_EQ(hash -> digest(), OpenPGP::Hash::use(length.first, "The quick brown fox jumps over the lazy dog"));
+    }
+
+    EXPECT_THROW(OpenPGP::Hash::create(4), std::runtime_error);
+    EXPECT_THROW(OpenPGP::Hash::use(100, "abc"), std::runtime_error);
+}
+
+TEST(Hash, clone) {
+    const std::string prefix(1000, 'p');
+    for(std::pair <const uint8_t, std::size_t> const & length : OpenPGP::Hash::LENGTH){
+        MerkleDamgard::Ptr hash = OpenPGP::Hash::create(length.first);
+        hash -> update(prefix);
+
+        // the copies continue independently from the same midstate
+        MerkleDamgard::Ptr first = hash -> clone();
+        MerkleDamgard::Ptr second = hash -> clone();
+        first -> update("first");
+        second -> update("second");
+
+        EXPECT_EQ(first -> digest(),  OpenPGP::Hash::use(length.first, prefix + "first"));
+        EXPECT_EQ(second -> digest(), OpenPGP::Hash::use(length.first, prefix + "second"));
+        EXPECT_EQ(hash -> digest(),   OpenPGP::Hash::use(length.first, prefix));
+    }
+}
@@ -13,3 +13,23 @@ TEST(MD5, vectors) {
         EXPECT_EQ(md5.hexdigest(), MD5_HASHES[i]);
     }
 }
+
+TEST(MD5, streaming) {
+    std::string data;
+    for(unsigned int i = 0; i < 1000; i++){
+        data += static_cast <char> (i * 7);
+    }
+
+    // odd sized pieces straddle block boundaries
+    MD5 md5;
+    const uint8_t * ptr = reinterpret_cast <const uint8_t *> (data.data());
+    for(std::size_t i = 0, n = 1; i < data.size(); i += n, n = (n * 3) % 97 + 1){
+        md5.update(ptr + i, std::min(n, data.size() - i));
+    }
+    EXPECT_EQ(md5.hexdigest(), MD5(data).hexdigest());
+
+    uint8_t out[16];
+    md5.digest(out);
+    EXPECT_EQ(std::string(reinterpret_cast <char *> (out), 16), md5.digest());
+    EXPECT_EQ(hexlify(md5.digest()), md5.hexdigest());
+}
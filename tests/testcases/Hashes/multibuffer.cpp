@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "Hashes/Hashes.h"
+
+// every length around the one and two block padding boundaries
+static std::vector <std::string> messages(){
+    std::vector <std::string> data;
+    for(unsigned int i = 0; i < 200; i++){
+        std::string msg(i, 0);
+        for(unsigned int j = 0; j < i; j++){
+            msg[j] = static_cast <char> (i * 31 + j);
+        }
+        data.push_back(msg);
+    }
+    return data;
+}
+
+TEST(MultiBuffer, lanes) {
+    if (!MultiBuffer::available()){
+        EXPECT_THROW(MultiBuffer::sha256({"abc"}), std::runtime_error);
+        return;
+    }
+
+    const std::vector <std::string> data = messages();
+    const std::vector <std::string> sha1   = MultiBuffer::sha1(data);
+    const std::vector <std::string> sha224 = MultiBuffer::sha224(data);
+    const std::vector <std::string> sha256 = MultiBuffer::sha256(data);
+
+    ASSERT_EQ(sha1.size(), data.size());
+    ASSERT_EQ(sha224.size(), data.size());
+    ASSERT_EQ(sha256.size(), data.size());
+
+    for ( unsigned int i = 0; i < data.size(); ++i ) {
+        EXPECT_EQ(sha1[i],   SHA1(data[i]).digest());
+        EXPECT_EQ(sha224[i], SHA224(data[i]).digest());
+        EXPECT_EQ(sha256[i], SHA256(data[i]).digest());
+    }
+
+    // fewer messages than lanes
+    EXPECT_EQ(MultiBuffer::sha256({"abc"}), std::vector <std::string> ({SHA256("abc").digest()}));
+    EXPECT_EQ(MultiBuffer::sha1({}).size(), 0U);
+}
+
+TEST(Hash, use_batch) {
+    const std::vector <std::string> data = messages();
+    for(uint8_t const alg : {OpenPGP::Hash::ID::MD5, OpenPGP::Hash::ID::SHA1, OpenPGP::Hash::ID::RIPEMD160,
+                             OpenPGP::Hash::ID::SHA256, OpenPGP::Hash::ID::SHA384, OpenPGP::Hash::ID::SHA512,
+                             OpenPGP::Hash::ID::SHA224}){
+        const std::vector <std::string> digests = OpenPGP::Hash::use_batch(alg, data);
+        ASSERT_EQ(digests.size(), data.size());
+        for ( unsigned int i = 0; i < data.size(); ++i ) {
+            EXPECT_EQ(digests[i], OpenPGP::Hash::use(alg, data[i]));
+        }
+    }
+}
@@ -1,4 +1,6 @@
-HASHES_TESTCASES_OBJECTS=md5.o          \
+HASHES_TESTCASES_OBJECTS=hashes.o       \
+                         md5.o          \
+                         multibuffer.o  \
                          ripemd160.o    \
                          sha1.o         \
                          sha224.o       \
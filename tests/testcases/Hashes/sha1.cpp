@@ -13,3 +13,18 @@ TEST(SHA1, short_msg) {
         EXPECT_EQ(sha1.hexdigest(), SHA1_SHORT_MSG_HEXDIGEST[i]);
     }
 }
+
+TEST(SHA1, implementations) {
+    for(SHA1::Implementation const impl : {SHA1::PORTABLE, SHA1::SHANI}){
+        if ((impl == SHA1::SHANI) && !SHANI::available()){
+            continue;
+        }
+
+        for ( unsigned int i = 0; i < SHA1_SHORT_MSG.size(); ++i ) {
+            EXPECT_EQ(SHA1(unhexlify(SHA1_SHORT_MSG[i]), impl).hexdigest(), SHA1_SHORT_MSG_HEXDIGEST[i]);
+        }
+
+        EXPECT_EQ(SHA1("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", impl).hexdigest(), "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+        EXPECT_EQ(SHA1(std::string(1000000, 'a'), impl).hexdigest(), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+    }
+}
@@ -13,3 +13,18 @@ TEST(SHA224, short_msg) {
         EXPECT_EQ(sha224.hexdigest(), SHA224_SHORT_MSG_HEXDIGEST[i]);
     }
 }
+
+TEST(SHA224, implementations) {
+    for(SHA256::Implementation const impl : {SHA256::PORTABLE, SHA256::AVX2, SHA256::SHANI}){
+        if (((impl == SHA256::AVX2) && !SHA2_AVX2::available()) ||
+            ((impl == SHA256::SHANI) && !SHANI::available())){
+            continue;
+        }
+
+        for ( unsigned int i = 0; i < SHA224_SHORT_MSG.size(); ++i ) {
+            EXPECT_EQ(SHA224(unhexlify(SHA224_SHORT_MSG[i]), impl).hexdigest(), SHA224_SHORT_MSG_HEXDIGEST[i]);
+        }
+
+        EXPECT_EQ(SHA224(std::string(1000000, 'a'), impl).hexdigest(), "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67");
+    }
+}
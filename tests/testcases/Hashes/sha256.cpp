@@ -14,3 +14,21 @@ TEST(SHA256, short_msg) {
     }
 }
 
+
+TEST(SHA256, implementations) {
+    for(SHA256::Implementation const impl : {SHA256::PORTABLE, SHA256::AVX2, SHA256::SHANI}){
+        if (((impl == SHA256::AVX2) && !SHA2_AVX2::available()) ||
+            ((impl == SHA256::SHANI) && !SHANI::available())){
+            continue;
+        }
+
+        for ( unsigned int i = 0; i < SHA256_SHORT_MSG.size(); ++i ) {
+            EXPECT_EQ(SHA256(unhexlify(SHA256_SHORT_MSG[i]), impl).hexdigest(), SHA256_SHORT_MSG_HEXDIGEST[i]);
+        }
+
+        // many blocks per call, odd and even counts
+        EXPECT_EQ(SHA256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", impl).hexdigest(), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+        EXPECT_EQ(SHA256(std::string(1000000, 'a'), impl).hexdigest(), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+        EXPECT_EQ(SHA256(std::string(64 * 3, 'a'), impl).hexdigest(), SHA256(std::string(64 * 3, 'a'), SHA256::PORTABLE).hexdigest());
+    }
+}
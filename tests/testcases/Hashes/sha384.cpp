@@ -15,3 +15,17 @@ TEST(SHA384, short_msg) {
 }
 
 
+
+TEST(SHA384, implementations) {
+    for(SHA512::Implementation const impl : {SHA512::PORTABLE, SHA512::AVX2}){
+        if ((impl == SHA512::AVX2) && !SHA2_AVX2::available()){
+            continue;
+        }
+
+        for ( unsigned int i = 0; i < SHA384_SHORT_MSG.size(); ++i ) {
+            EXPECT_EQ(SHA384(unhexlify(SHA384_SHORT_MSG[i]), impl).hexdigest(), SHA384_SHORT_MSG_HEXDIGEST[i]);
+        }
+
+        EXPECT_EQ(SHA384(std::string(1000000, 'a'), impl).hexdigest(), "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985");
+    }
+}
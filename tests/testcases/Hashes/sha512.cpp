@@ -15,3 +15,41 @@ TEST(SHA512, short_msg) {
 }
 
 
+
+TEST(SHA512, streaming) {
+    std::string data;
+    for(unsigned int i = 0; i < 1000; i++){
+        data += static_cast <char> (i * 7);
+    }
+
+    // odd sized pieces straddle block boundaries
+    SHA512 sha512;
+    const uint8_t * ptr = reinterpret_cast <const uint8_t *> (data.data());
+    for(std::size_t i = 0, n = 1; i < data.size(); i += n, n = (n * 3) % 197 + 1){
+        sha512.update(ptr + i, std::min(n, data.size() - i));
+    }
+    EXPECT_EQ(sha512.hexdigest(), SHA512(data).hexdigest());
+
+    uint8_t out[64];
+    sha512.digest(out);
+    EXPECT_EQ(std::string(reinterpret_cast <char *> (out), 64), sha512.digest());
+
+    // digest does not change the state
+    sha512.update("abc");
+    EXPECT_EQ(sha512.hexdigest(), SHA512(data + "abc").hexdigest());
+}
+
+TEST(SHA512, implementations) {
+    for(SHA512::Implementation const impl : {SHA512::PORTABLE, SHA512::AVX2}){
+        if ((impl == SHA512::AVX2) && !SHA2_AVX2::available()){
+            continue;
+        }
+
+        for ( unsigned int i = 0; i < SHA512_SHORT_MSG.size(); ++i ) {
+            EXPECT_EQ(SHA512(unhexlify(SHA512_SHORT_MSG[i]), impl).hexdigest(), SHA512_SHORT_MSG_HEXDIGEST[i]);
+        }
+
+        EXPECT_EQ(SHA512("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", impl).hexdigest(), "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+        EXPECT_EQ(SHA512(std::string(1000000, 'a'), impl).hexdigest(), "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+    }
+}
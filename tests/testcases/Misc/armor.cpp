@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "Misc/armor.h"
+
+static std::string data(){
+    std::string out;
+    for(unsigned int i = 0; i < 1000; i++){
+        out += std::string(1, static_cast <char> (i * 37));
+    }
+    return out;
+}
+
+static std::string checksum(const std::string & str){
+    return "=" + OpenPGP::ascii2radix64(unhexlify(makehex(OpenPGP::crc24(str), 6)));
+}
+
+// split encoded data into lines of the given length
+static std::string body(const std::string & str, const std::size_t line_length, const std::string & eol = "\n"){
+    const std::string encoded = OpenPGP::ascii2radix64(str);
+    std::string out;
+    for(std::size_t i = 0; i < encoded.size(); i += line_length){
+        out += encoded.substr(i, line_length) + eol;
+    }
+    return out;
+}
+
+static std::string decode(OpenPGP::ArmorReader & reader){
+    std::istream stream(&reader);
+    return std::string(std::istreambuf_iterator <char> (stream), {});
+}
+
+TEST(ArmorReader, decode){
+
+    const std::string str = data();
+
+    // line lengths that do not line up with 4 character groups are fine
+    for(const std::size_t line_length : {64, 76, 10, 3}){
+        std::stringstream s(body(str, line_length) + checksum(str) + "\n-----END PGP MESSAGE-----\nafter\n");
+        OpenPGP::ArmorReader reader(s);
+        EXPECT_EQ(decode(reader), str);
+        EXPECT_TRUE(reader.finished());
+        EXPECT_TRUE(reader.has_checksum());
+        EXPECT_TRUE(reader.valid());
+
+        // the tail is consumed, but nothing after it
+        std::string line;
+        EXPECT_TRUE(std::getline(s, line));
+        EXPECT_EQ(line, "after");
+    }
+}
+
+TEST(ArmorReader, crlf){
+
+    const std::string str = data().substr(0, 100);
+    std::stringstream s(body(str, 64, "\r\n") + checksum(str) + "\r\n-----END PGP MESSAGE-----\r\n");
+    OpenPGP::ArmorReader reader(s);
+    EXPECT_EQ(decode(reader), str);
+    EXPECT_TRUE(reader.valid());
+}
+
+TEST(ArmorReader, checksum){
+
+    const std::string str = data().substr(0, 200);
+
+    {
+        std::stringstream s(body(str, 64) + "-----END PGP MESSAGE-----\n");
+        OpenPGP::ArmorReader reader(s);
+        EXPECT_EQ(decode(reader), str);
+        EXPECT_FALSE(reader.has_checksum());
+        EXPECT_FALSE(reader.valid());
+    }
+
+    {
+        std::stringstream s(body(str, 64) + checksum(str.substr(1)) + "\n-----END PGP MESSAGE-----\n");
+        OpenPGP::ArmorReader reader(s);
+        EXPECT_EQ(decode(reader), str);
+        EXPECT_TRUE(reader.has_checksum());
+        EXPECT_FALSE(reader.valid());
+    }
+}
+
+TEST(ArmorReader, invalid){
+
+    std::stringstream s("Zm9v\nZm*v\n-----END PGP MESSAGE-----\n");
+    OpenPGP::ArmorReader reader(s);
+    EXPECT_THROW(decode(reader), std::runtime_error);
+
+    std::stringstream t("Zm9vZ\n-----END PGP MESSAGE-----\n");
+    OpenPGP::ArmorReader truncated(t);
+    EXPECT_THROW(decode(truncated), std::runtime_error);
+}
+
+TEST(ArmorWriter, format){
+
+    const std::string str = data();
+    const OpenPGP::ArmorWriter::Keys keys = {std::make_pair("Version", "test")};
+
+    // the same layout as formatting the whole encoded string at once
+    std::string expected = "-----BEGIN PGP MESSAGE-----\nVersion: test\n\n" + body(str, OpenPGP::MAX_LINE_LENGTH) + checksum(str) + "\n-----END PGP MESSAGE-----\n";
+
+    // write in uneven pieces
+    std::stringstream s;
+    {
+        OpenPGP::ArmorWriter writer(s, "MESSAGE", keys);
+        std::ostream out(&writer);
+        for(std::size_t i = 0; i < str.size(); i += 77){
+            out << str.substr(i, 77);
+        }
+        out.flush();
+        writer.close();
+    }
+    EXPECT_EQ(s.str(), expected);
+
+    // closed by the destructor
+    std::stringstream t;
+    {
+        OpenPGP::ArmorWriter writer(t, "MESSAGE", keys);
+        writer.sputn(str.data(), str.size());
+    }
+    EXPECT_EQ(t.str(), expected);
+}
+
+TEST(ArmorWriter, empty){
+
+    std::stringstream s;
+    OpenPGP::ArmorWriter(s, "SIGNATURE");
+    EXPECT_EQ(s.str(), "-----BEGIN PGP SIGNATURE-----\n\n" + checksum("") + "\n-----END PGP SIGNATURE-----\n");
+}
+
+TEST(ArmorWriter, round_trip){
+
+    const std::string str = data();
+
+    std::stringstream s;
+    {
+        OpenPGP::ArmorWriter writer(s, "MESSAGE");
+        writer.sputn(str.data(), str.size());
+    }
+
+    // skip the Armor Header Line and the blank line
+    std::string line;
+    std::getline(s, line);
+    std::getline(s, line);
+
+    OpenPGP::ArmorReader reader(s);
+    EXPECT_EQ(decode(reader), str);
+    EXPECT_TRUE(reader.valid());
+}
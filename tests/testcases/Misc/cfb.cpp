@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "Misc/cfb.h"
+
+static std::string pattern(const std::size_t size, const uint8_t seed){
+    std::string out(size, 0);
+    for(std::size_t i = 0; i < size; i++){
+        out[i] = static_cast <char> (i * seed + (i >> 8));
+    }
+    return out;
+}
+
+// decrypting must return the prefix, the 2 check octets and then the data
+static void cfb_round_trip(const uint8_t sym, const uint8_t packet, const std::string & data, const unsigned int threads){
+    const std::size_t BS = OpenPGP::Sym::BLOCK_LENGTH.at(sym) >> 3;
+    const std::string key = pattern(OpenPGP::Sym::KEY_LENGTH.at(sym) >> 3, 11);
+    std::string prefix = pattern(BS, 29);
+    prefix += prefix.substr(BS - 2, 2);
+
+    const std::string encrypted = OpenPGP::use_OpenPGP_CFB_encrypt(sym, packet, data, key, prefix);
+    EXPECT_EQ(OpenPGP::use_OpenPGP_CFB_decrypt(sym, packet, encrypted, key, threads), prefix + data);
+}
+
+TEST(CFB, OpenPGP_decrypt){
+    for(uint8_t const sym : {OpenPGP::Sym::ID::CAST5, OpenPGP::Sym::ID::AES128, OpenPGP::Sym::ID::AES256}){
+        for(uint8_t const packet : {OpenPGP::Packet::SYMMETRICALLY_ENCRYPTED_DATA, OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA}){
+            // empty, partial, single and many blocks
+            for(std::size_t const size : {0, 1, 7, 8, 16, 17, 1000, 5000}){
+                cfb_round_trip(sym, packet, pattern(size, 7), 1);
+            }
+        }
+    }
+}
+
+TEST(CFB, OpenPGP_decrypt_threads){
+    // large enough to be split, with a partial last block
+    const std::string data = pattern(OpenPGP::CFB_PARALLEL_THRESHOLD + 12345, 3);
+    for(uint8_t const packet : {OpenPGP::Packet::SYMMETRICALLY_ENCRYPTED_DATA, OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA}){
+        cfb_round_trip(OpenPGP::Sym::ID::AES128, packet, data, 4);
+        cfb_round_trip(OpenPGP::Sym::ID::CAST5,  packet, data, 0);
+    }
+}
+
+TEST(CFB, OpenPGP_decrypt_bad_check){
+    const std::string key(16, 1);
+    std::string encrypted = OpenPGP::use_OpenPGP_CFB_encrypt(OpenPGP::Sym::ID::AES128, OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA, "data", key, std::string(18, 0));
+    encrypted[17] ^= 1;
+    EXPECT_THROW(OpenPGP::use_OpenPGP_CFB_decrypt(OpenPGP::Sym::ID::AES128, OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA, encrypted, key), std::runtime_error);
+}
+
+TEST(CFB, OpenPGP_encrypt_buffer){
+    const SymAlg::Ptr alg = OpenPGP::Sym::setup(OpenPGP::Sym::ID::AES128, pattern(16, 5));
+    std::string prefix = pattern(16, 9);
+    prefix += prefix.substr(14, 2);
+    const std::string data = pattern(100, 1);
+
+    for(uint8_t const packet : {OpenPGP::Packet::SYMMETRICALLY_ENCRYPTED_DATA, OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA}){
+        const std::string expected = OpenPGP::OpenPGP_CFB_encrypt(alg, packet, data, prefix);
+
+        // separate output buffer
+        const std::string in = prefix + data;
+        std::string out(in.size(), 0);
+        OpenPGP::OpenPGP_CFB_encrypt(alg, packet, reinterpret_cast <const uint8_t *> (in.data()), reinterpret_cast <uint8_t *> (&out[0]), in.size());
+        EXPECT_EQ(out, expected);
+
+        // in place
+        std::string buf = prefix + data;
+        OpenPGP::OpenPGP_CFB_encrypt_in_place(alg, packet, buf);
+        EXPECT_EQ(buf, expected);
+    }
+}
+
+// feed data through in chunks of varying size
+template <typename Stream> static std::string chunked(Stream & cfb, const std::string & data){
+    std::string out;
+    std::size_t x = 0, step = 1;
+    while (x < data.size()){
+        out += cfb.update(data.substr(x, step));
+        x += step;
+        step = (step * 5 + 3) % 41;
+    }
+    cfb.finish();
+    return out;
+}
+
+TEST(CFB, streaming_normal){
+    const SymAlg::Ptr alg = OpenPGP::Sym::setup(OpenPGP::Sym::ID::CAST5, pattern(16, 5));
+    const std::string IV = pattern(8, 17);
+    const std::string data = pattern(1000, 3);
+
+    const std::string encrypted = OpenPGP::normal_CFB_encrypt(alg, data, IV);
+
+    OpenPGP::CFBEncryptor enc(alg, IV);
+    EXPECT_EQ(chunked(enc, data), encrypted);
+    EXPECT_THROW(enc.update(data), std::runtime_error);
+
+    OpenPGP::CFBDecryptor dec(alg, IV);
+    EXPECT_EQ(chunked(dec, encrypted), data);
+
+    EXPECT_EQ(OpenPGP::normal_CFB_decrypt(alg, encrypted, IV), data);
+}
+
+TEST(CFB, streaming_OpenPGP){
+    const SymAlg::Ptr alg = OpenPGP::Sym::setup(OpenPGP::Sym::ID::AES192, pattern(24, 5));
+    std::string prefix = pattern(16, 9);
+    prefix += prefix.substr(14, 2);
+    const std::string data = pattern(777, 1);
+
+    for(uint8_t const packet : {OpenPGP::Packet::SYMMETRICALLY_ENCRYPTED_DATA, OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA}){
+        const std::string encrypted = OpenPGP::OpenPGP_CFB_encrypt(alg, packet, data, prefix);
+
+        OpenPGP::CFBEncryptor enc(alg, packet);
+        EXPECT_EQ(chunked(enc, prefix + data), encrypted);
+
+        OpenPGP::CFBDecryptor dec(alg, packet);
+        EXPECT_EQ(chunked(dec, encrypted), prefix + data);
+
+        // wrong key is caught by the check octets
+        OpenPGP::CFBDecryptor bad(OpenPGP::Sym::setup(OpenPGP::Sym::ID::AES192, pattern(24, 6)), packet);
+        EXPECT_THROW(bad.update(encrypted), std::runtime_error);
+
+        // stream ended inside the prefix
+        OpenPGP::CFBDecryptor partial(alg, packet);
+        partial.update(encrypted.substr(0, 10));
+        EXPECT_THROW(partial.finish(), std::runtime_error);
+    }
+}
+
+TEST(CFB, OpenPGP_decrypt_sink){
+    const SymAlg::Ptr alg = OpenPGP::Sym::setup(OpenPGP::Sym::ID::AES128, pattern(16, 5));
+    std::string prefix = pattern(16, 9);
+    prefix += prefix.substr(14, 2);
+    const std::string data = pattern(5000, 1);
+
+    for(uint8_t const packet : {OpenPGP::Packet::SYMMETRICALLY_ENCRYPTED_DATA, OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA}){
+        const std::string encrypted = OpenPGP::OpenPGP_CFB_encrypt(alg, packet, data, prefix);
+
+        // the sink sees the whole output once, in order
+        std::string seen;
+        const std::string out = OpenPGP::OpenPGP_CFB_decrypt(alg, packet, encrypted,
+                                                             [&seen](const uint8_t * plain, const std::size_t len){
+                                                                 seen.append(reinterpret_cast <const char *> (plain), len);
+                                                             });
+        EXPECT_EQ(out, prefix + data);
+        EXPECT_EQ(seen, out);
+    }
+}
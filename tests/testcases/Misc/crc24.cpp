@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "Misc/CRC-24.h"
+
+// RFC 4880 sec 6.1
+static uint32_t crc_octets(const std::string & str){
+    uint32_t crc = OpenPGP::CRC24_INIT;
+    for(unsigned char const c : str){
+        crc ^= static_cast <uint32_t> (c) << 16;
+        for(uint8_t i = 0; i < 8; i++){
+            crc <<= 1;
+            if (crc & 0x1000000){
+                crc ^= 0x1864CFB;
+            }
+        }
+    }
+    return crc & 0xFFFFFF;
+}
+
+TEST(CRC24, check){
+
+    EXPECT_EQ(OpenPGP::crc24(""), OpenPGP::CRC24_INIT);
+    EXPECT_EQ(OpenPGP::crc24("123456789"), 0x21CF02U);
+}
+
+TEST(CRC24, lengths){
+
+    std::string data;
+    for(unsigned int i = 0; i < 1000; i++){
+        data += std::string(1, static_cast <char> ((i * 131) ^ (i >> 3)));
+    }
+
+    // short inputs use the table, long ones are folded first
+    for(std::size_t len = 0; len <= data.size(); len += (len < 200)?1:37){
+        const std::string str = data.substr(0, len);
+        ASSERT_EQ(OpenPGP::crc24(str), crc_octets(str));
+    }
+}
+
+TEST(CRC24, update){
+
+    std::string data;
+    for(unsigned int i = 0; i < 500; i++){
+        data += std::string(1, static_cast <char> (i * 7));
+    }
+    const uint32_t expected = crc_octets(data);
+    const uint8_t * ptr = reinterpret_cast <const uint8_t *> (data.data());
+
+    for(const std::size_t split : {std::size_t(0), std::size_t(1), std::size_t(63), std::size_t(64), std::size_t(250), data.size()}){
+        uint32_t crc = OpenPGP::CRC24_INIT;
+        crc = OpenPGP::crc24_update(crc, ptr, split);
+        crc = OpenPGP::crc24_update(crc, ptr + split, data.size() - split);
+        EXPECT_EQ(crc, expected);
+    }
+}
@@ -1,2 +1,6 @@
-MISC_TESTCASES_OBJECTS=mpi.o         \
-                       radix64.o
\ No newline at end of file
+MISC_TESTCASES_OBJECTS=armor.o       \
+                       cfb.o         \
+                       crc24.o       \
+                       mpi.o         \
+                       radix64.o     \
+                       s2k.o
\ No newline at end of file
@@ -23,3 +23,49 @@ TEST(Radix64, rfc4648_base64_test_vectors){
     EXPECT_EQ(OpenPGP::radix642ascii("Zm9vYmFy"), "foobar");
 
 }
+
+TEST(Radix64, round_trip){
+
+    std::string data;
+    for(unsigned int i = 0; i < 300; i++){
+        data += std::string(1, static_cast <char> ((i * 167) + 13));
+    }
+
+    // every length, so the vector and scalar paths both get the tail
+    for(std::size_t len = 0; len <= data.size(); len++){
+        const std::string str = data.substr(0, len);
+        const std::string encoded = OpenPGP::ascii2radix64(str);
+
+        // encoding is independent per 3 octet group
+        std::string expected;
+        for(std::size_t i = 0; i < len; i += 3){
+            expected += OpenPGP::ascii2radix64(str.substr(i, 3));
+        }
+        ASSERT_EQ(encoded, expected);
+        ASSERT_EQ(OpenPGP::radix642ascii(encoded), str);
+    }
+}
+
+TEST(Radix64, custom_characters){
+
+    const std::string data(100, '\xfb');
+    const std::string encoded = OpenPGP::ascii2radix64(data, '-', '_');
+    EXPECT_EQ(encoded.find_first_of("+/"), std::string::npos);
+    EXPECT_EQ(encoded.substr(0, 4), "-_v7");
+    EXPECT_EQ(OpenPGP::radix642ascii(encoded, '-', '_'), data);
+    EXPECT_THROW(OpenPGP::radix642ascii(encoded), std::runtime_error);
+}
+
+TEST(Radix64, invalid_character){
+
+    std::string encoded = OpenPGP::ascii2radix64(std::string(96, 'x'));
+
+    // inside a vector block and in the scalar tail
+    for(const std::size_t i : {std::size_t(5), encoded.size() - 2}){
+        std::string bad = encoded;
+        bad[i] = '*';
+        EXPECT_THROW(OpenPGP::radix642ascii(bad), std::runtime_error);
+    }
+
+    EXPECT_THROW(OpenPGP::radix642ascii("Zm9"), std::runtime_error);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "Misc/s2k.h"
+
+static OpenPGP::S2K::S2K3 s2k3(const uint8_t hash, const uint8_t count){
+    OpenPGP::S2K::S2K3 s2k;
+    s2k.set_hash(hash);
+    s2k.set_salt(unhexlify("0102030405060708"));
+    s2k.set_count(count);
+    return s2k;
+}
+
+TEST(S2K, iterated_and_salted){
+    // 65536 octets, 2 SHA-1 contexts
+    EXPECT_EQ(hexlify(s2k3(OpenPGP::Hash::ID::SHA1, 96).run("password", 32)), "19fadb83496d201eb48e03e4ee94ef72f0a4fb704163f5e4f3b0277fdc86b973");
+
+    // 65011712 octets
+    EXPECT_EQ(hexlify(s2k3(OpenPGP::Hash::ID::SHA256, 255).run("password", 32)), "776c7580c2f01134756dd623d405ad6eae2bb57edd04b266b60892a31c6a6c1a");
+
+    // salt + pass longer than the octet count is hashed completely
+    EXPECT_EQ(hexlify(s2k3(OpenPGP::Hash::ID::SHA1, 0).run(std::string(2000, 'x'), 16)), "cec432014e38301e6495461181f1907d");
+}
+
+TEST(S2K, cache){
+    OpenPGP::S2K::Cache & cache = OpenPGP::S2K::Cache::instance();
+    OpenPGP::S2K::S2K3 s2k = s2k3(OpenPGP::Hash::ID::SHA256, 96);
+    const std::string expected = s2k.run("password", 32);
+
+    // disabled by default
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_EQ(cache.size(), 0U);
+
+    cache.configure(2, std::chrono::seconds(60));
+    EXPECT_EQ(s2k.run("password", 32), expected);
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_EQ(s2k.run("password", 32), expected);
+    EXPECT_EQ(cache.size(), 1U);
+
+    // different passphrases and key lengths are different entries
+    EXPECT_NE(s2k.run("Password", 32), expected);
+    EXPECT_EQ(s2k.run("password", 16), expected.substr(0, 16));
+
+    // least recently used entry was dropped
+    EXPECT_EQ(cache.size(), 2U);
+    std::string value;
+    EXPECT_TRUE(cache.get(s2k.raw() + unhexlify("00000010") + OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, "password"), value));
+    EXPECT_EQ(value, expected.substr(0, 16));
+
+    // expired entries are not used
+    cache.configure(2, std::chrono::seconds(0));
+    EXPECT_EQ(s2k.run("password", 32), expected);
+    EXPECT_FALSE(cache.get(s2k.raw() + unhexlify("00000020") + OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, "password"), value));
+
+    // replacing an existing key drops the old entry
+    cache.configure(2, std::chrono::seconds(60));
+    cache.put("key", "old");
+    cache.put("key", "new");
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_TRUE(cache.get("key", value));
+    EXPECT_EQ(value, "new");
+
+    cache.configure(0, std::chrono::seconds(0));
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(S2K, calibrate){
+    const uint8_t fast = OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::ID::SHA256, std::chrono::milliseconds(1));
+    const uint8_t slow = OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::ID::SHA256, std::chrono::milliseconds(50));
+    EXPECT_LE(fast, slow);
+
+    // nothing takes an hour
+    EXPECT_EQ(OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::ID::SHA1, std::chrono::milliseconds(3600000)), 255);
+}
@@ -0,0 +1,57 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "common/Arena.h"
+
+TEST(Arena, allocate){
+
+    OpenPGP::Arena arena(64);
+    EXPECT_EQ(arena.get_used(), (std::size_t) 0);
+    EXPECT_EQ(arena.get_reserved(), (std::size_t) 0);
+
+    void * a = arena.allocate(3, 1);
+    void * b = arena.allocate(8, 8);
+    EXPECT_EQ(reinterpret_cast <uintptr_t> (b) % 8, (uintptr_t) 0);
+    EXPECT_GT(b, a);
+    EXPECT_EQ(arena.get_used(), (std::size_t) 11);
+    EXPECT_EQ(arena.get_reserved(), (std::size_t) 64);
+
+    // larger than a chunk
+    arena.allocate(100, 16);
+    EXPECT_GT(arena.get_reserved(), (std::size_t) 164);
+
+    EXPECT_THROW(OpenPGP::Arena(0), std::runtime_error);
+}
+
+TEST(Arena, scope){
+
+    const OpenPGP::Arena::Ptr outer = std::make_shared <OpenPGP::Arena> ();
+    const OpenPGP::Arena::Ptr inner = std::make_shared <OpenPGP::Arena> ();
+
+    EXPECT_EQ(OpenPGP::Arena::current(), nullptr);
+    {
+        OpenPGP::Arena::Scope a(outer);
+        EXPECT_EQ(OpenPGP::Arena::current(), outer);
+        {
+            OpenPGP::Arena::Scope b(inner);
+            EXPECT_EQ(OpenPGP::Arena::current(), inner);
+            {
+                OpenPGP::Arena::Scope c(nullptr);
+                EXPECT_EQ(OpenPGP::Arena::current(), inner);
+            }
+        }
+        EXPECT_EQ(OpenPGP::Arena::current(), outer);
+
+        const std::shared_ptr <std::uint64_t> value = OpenPGP::arena_make_shared <std::uint64_t> (42);
+        EXPECT_EQ(*value, (std::uint64_t) 42);
+        EXPECT_GE(outer -> get_used(), sizeof(std::uint64_t));
+        EXPECT_EQ(outer.use_count(), 3);
+    }
+    EXPECT_EQ(OpenPGP::Arena::current(), nullptr);
+
+    // no arena in scope, so this comes from the heap
+    const std::shared_ptr <std::uint64_t> value = OpenPGP::arena_make_shared <std::uint64_t> (7);
+    EXPECT_EQ(*value, (std::uint64_t) 7);
+    EXPECT_EQ(outer.use_count(), 1);
+}
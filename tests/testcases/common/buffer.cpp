@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include <gtest/gtest.h>
+
+#include "common/Buffer.h"
+
+TEST(Buffer, own){
+
+    const OpenPGP::Buffer::Ptr buffer = OpenPGP::Buffer::own("0123456789");
+    EXPECT_EQ(buffer -> size(), (std::size_t) 10);
+    EXPECT_EQ(std::string(buffer -> data(), buffer -> size()), "0123456789");
+}
+
+TEST(Buffer, map){
+
+    const std::string filename = "buffer_map_test";
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f << std::string("\x00\x01\x02\x03", 4) << "abc";
+    }
+
+    const OpenPGP::Buffer::Ptr buffer = OpenPGP::Buffer::map(filename);
+    EXPECT_EQ(std::string(buffer -> data(), buffer -> size()), std::string("\x00\x01\x02\x03", 4) + "abc");
+    std::remove(filename.c_str());
+
+    EXPECT_THROW(OpenPGP::Buffer::map(filename), std::runtime_error);
+}
+
+TEST(Slice, slicing){
+
+    const OpenPGP::Buffer::Ptr buffer = OpenPGP::Buffer::own("0123456789");
+    const OpenPGP::Slice all(buffer);
+    EXPECT_EQ(all.size(), (std::size_t) 10);
+    EXPECT_EQ(all.str(), "0123456789");
+
+    // slices share the buffer
+    const OpenPGP::Slice middle = all.slice(2, 5);
+    EXPECT_EQ(middle.data(), buffer -> data() + 2);
+    EXPECT_EQ(middle.str(), "23456");
+    EXPECT_EQ(middle[0], '2');
+    EXPECT_EQ(middle.substr(1, 2), "34");
+    EXPECT_EQ(middle.slice(3).str(), "56");
+    EXPECT_EQ(buffer.use_count(), 3);
+
+    // lengths are clamped like std::string::substr; positions are not
+    EXPECT_EQ(all.slice(8, 100).str(), "89");
+    EXPECT_TRUE(all.slice(10).empty());
+    EXPECT_THROW(all.slice(11), std::out_of_range);
+    EXPECT_THROW(middle.substr(6), std::out_of_range);
+
+    EXPECT_THROW(middle[5], std::out_of_range);
+    EXPECT_THROW(OpenPGP::Slice()[0], std::out_of_range);
+
+    EXPECT_TRUE(OpenPGP::Slice().empty());
+    EXPECT_EQ(OpenPGP::Slice("abc").str(), "abc");
+}
+
+TEST(SliceBuf, read){
+
+    const OpenPGP::Buffer::Ptr buffer = OpenPGP::Buffer::own("0123456789");
+    OpenPGP::SliceBuf buf(OpenPGP::Slice(buffer, 2, 6));
+    std::istream s(&buf);
+
+    // reads straight out of the buffer
+    EXPECT_EQ(s.get(), '2');
+    EXPECT_EQ(buf.sgetc(), '3');
+    EXPECT_EQ(std::string(std::istreambuf_iterator <char> (s), {}), "34567");
+
+    // seeking stays within the slice
+    s.clear();
+    EXPECT_EQ(s.seekg(-2, std::ios::end).tellg(), std::istream::pos_type(4));
+    EXPECT_EQ(s.get(), '6');
+    EXPECT_FALSE(s.seekg(7));
+    s.clear();
+    EXPECT_TRUE(s.seekg(0));
+    EXPECT_EQ(s.get(), '2');
+}
@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+
+#include "common/CPU.h"
+#include "Encryptions/AESNI.h"
+#include "Hashes/SHA2_AVX2.h"
+#include "Hashes/SHANI.h"
+
+TEST(CPU, features){
+    // the accelerated implementations agree with the shared detection
+    EXPECT_EQ(AESNI::available(), OpenPGP::CPU::aes());
+    EXPECT_EQ(SHA2_AVX2::available(), OpenPGP::CPU::avx2());
+    EXPECT_EQ(SHANI::available(), OpenPGP::CPU::sha() && OpenPGP::CPU::sse41() && OpenPGP::CPU::ssse3());
+
+#ifndef CPU_X86
+    EXPECT_FALSE(OpenPGP::CPU::ssse3());
+    EXPECT_FALSE(OpenPGP::CPU::avx2());
+#endif
+}
@@ -1 +1,3 @@
-COMMON_TESTCASES_OBJECTS=
\ No newline at end of file
+COMMON_TESTCASES_OBJECTS=arena.o \
+                         buffer.o \
+                         cpu.o
\ No newline at end of file
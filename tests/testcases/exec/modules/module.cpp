@@ -171,4 +171,20 @@ TEST(Module, module){
                                        })
                        );
     }
-}
\ No newline at end of file
+}
+
+TEST(Module, to_ulong){
+    unsigned long value = 0;
+    EXPECT_TRUE(module::to_ulong("0", value));
+    EXPECT_EQ(value, 0UL);
+    EXPECT_TRUE(module::to_ulong("255", value));
+    EXPECT_EQ(value, 255UL);
+
+    EXPECT_FALSE(module::to_ulong("", value));
+    EXPECT_FALSE(module::to_ulong("foo", value));
+    EXPECT_FALSE(module::to_ulong("12x", value));
+    EXPECT_FALSE(module::to_ulong(" 12", value));
+    EXPECT_FALSE(module::to_ulong("-1", value));
+    EXPECT_FALSE(module::to_ulong("+1", value));
+    EXPECT_FALSE(module::to_ulong("99999999999999999999999999", value));
+}
@@ -1,2 +1,3 @@
 TESTCASES_OBJECTS=gpg.o \
+                  packetreader.o \
                   pgp.o
\ No newline at end of file
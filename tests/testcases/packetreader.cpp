@@ -0,0 +1,221 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "PacketReader.h"
+#include "encrypt.h"
+#include "Misc/armor.h"
+
+#include "testvectors/msg.h"
+#include "testvectors/pass.h"
+
+static OpenPGP::Message encrypted(){
+    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    return OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Sym::ID::AES256);
+}
+
+TEST(PacketReader, read){
+
+    const OpenPGP::Message message = encrypted();
+
+    for(const OpenPGP::Packet::Tag::Format format : {OpenPGP::Packet::Tag::Format::NEW, OpenPGP::Packet::Tag::Format::OLD}){
+        std::stringstream s(message.write(OpenPGP::PGP::Armored::NO, format));
+        OpenPGP::PacketReader reader(s);
+        OpenPGP::PacketReader::Header header;
+
+        for(OpenPGP::Packet::Tag::Ptr const & expected : message.get_packets()){
+            ASSERT_TRUE(reader.next(header));
+            EXPECT_EQ(header.tag, expected -> get_tag());
+            EXPECT_EQ(header.format, static_cast <bool> (expected -> write(format)[0] & 0x40));   // tags above 15 are always NEW
+            EXPECT_FALSE(header.partial);
+            EXPECT_EQ(header.length, expected -> raw().size());
+
+            const OpenPGP::Packet::Tag::Ptr packet = reader.packet();
+            EXPECT_EQ(packet -> raw(), expected -> raw());
+        }
+        EXPECT_FALSE(reader.next(header));
+    }
+}
+
+TEST(PacketReader, skip){
+
+    const OpenPGP::Message message = encrypted();
+    const std::string binary = message.write(OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW);
+    const std::string last = message.get_packets().back() -> raw();
+
+    // seekable
+    {
+        std::stringstream s(binary);
+        OpenPGP::PacketReader reader(s);
+        OpenPGP::PacketReader::Header header;
+        ASSERT_TRUE(reader.next(header));
+        ASSERT_TRUE(reader.next(header));
+        EXPECT_EQ(reader.read_body(), last);
+        EXPECT_FALSE(reader.next(header));
+    }
+
+    // not seekable, after reading part of the body
+    {
+        std::stringstream armored;
+        {
+            OpenPGP::ArmorWriter writer(armored, "MESSAGE");
+            writer.sputn(binary.data(), binary.size());
+        }
+        std::string line;
+        std::getline(armored, line);
+        std::getline(armored, line);
+
+        OpenPGP::ArmorReader decoder(armored);
+        std::istream s(&decoder);
+        OpenPGP::PacketReader reader(s);
+        OpenPGP::PacketReader::Header header;
+        ASSERT_TRUE(reader.next(header));
+        EXPECT_NE(reader.body().get(), EOF);
+        ASSERT_TRUE(reader.next(header));
+        EXPECT_EQ(reader.read_body(), last);
+        EXPECT_FALSE(reader.next(header));
+    }
+}
+
+TEST(PacketReader, partial){
+
+    // Literal Data split into chunks of 2 and 4 octets, then a final 8 octets
+    const std::string body = std::string("b\x03""abc\x00\x00\x00\x00", 9) + "hello";
+    const std::string data = "\xcb\xe1" + body.substr(0, 2) + "\xe2" + body.substr(2, 4) + "\x08" + body.substr(6) + "\xca\x03PGP";
+    std::stringstream s(data);
+
+    OpenPGP::PacketReader reader(s);
+    OpenPGP::PacketReader::Header header;
+    ASSERT_TRUE(reader.next(header));
+    EXPECT_EQ(header.tag, OpenPGP::Packet::LITERAL_DATA);
+    EXPECT_TRUE(header.partial);
+
+    const OpenPGP::Packet::Tag11::Ptr literal = std::static_pointer_cast <OpenPGP::Packet::Tag11> (reader.packet());
+    EXPECT_EQ(literal -> get_filename(), "abc");
+    EXPECT_EQ(literal -> get_literal(), "hello");
+
+    // the next packet follows the last chunk
+    ASSERT_TRUE(reader.next(header));
+    EXPECT_EQ(header.tag, OpenPGP::Packet::MARKER_PACKET);
+    EXPECT_EQ(reader.read_body(), "PGP");
+    EXPECT_FALSE(reader.next(header));
+}
+
+TEST(PacketReader, indeterminate){
+
+    // old format, length type 3: the body runs to the end of the stream
+    std::stringstream s("\xab" "PGPPGP");
+    OpenPGP::PacketReader reader(s);
+    OpenPGP::PacketReader::Header header;
+    ASSERT_TRUE(reader.next(header));
+    EXPECT_EQ(header.tag, OpenPGP::Packet::MARKER_PACKET);
+    EXPECT_TRUE(header.partial);
+    EXPECT_EQ(reader.read_body(), "PGPPGP");
+    EXPECT_FALSE(reader.next(header));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(PacketReader, fd){
+
+    const OpenPGP::Message message = encrypted();
+    const std::string binary = message.write(OpenPGP::PGP::Armored::NO, OpenPGP::Packet::Tag::Format::NEW);
+
+    // a pipe cannot seek, so the first body is read past
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], binary.data(), binary.size()), static_cast <ssize_t> (binary.size()));
+    close(fds[1]);
+
+    {
+        OpenPGP::PacketReader reader(fds[0]);
+        OpenPGP::PacketReader::Header header;
+        ASSERT_TRUE(reader.next(header));
+        EXPECT_EQ(header.tag, message.get_packets().front() -> get_tag());
+        ASSERT_TRUE(reader.next(header));
+        EXPECT_EQ(reader.packet() -> raw(), message.get_packets().back() -> raw());
+        EXPECT_FALSE(reader.next(header));
+    }
+    close(fds[0]);
+
+    // read errors are reported
+    OpenPGP::PacketReader bad(-1);
+    OpenPGP::PacketReader::Header header;
+    EXPECT_THROW(bad.next(header), std::runtime_error);
+}
+#endif
+
+TEST(PacketReader, errors){
+
+    OpenPGP::PacketReader::Header header;
+
+    std::stringstream bad("\x0a\x03PGP");
+    OpenPGP::PacketReader first_bit(bad);
+    EXPECT_THROW(first_bit.next(header), std::runtime_error);
+
+    std::stringstream truncated("\xca\x05PGP");
+    OpenPGP::PacketReader short_body(truncated);
+    ASSERT_TRUE(short_body.next(header));
+    EXPECT_THROW(short_body.read_body(), std::runtime_error);
+
+    // skipping a truncated body must not look like a clean end of stream;
+    // files allow seeking past their end, so use one
+    const std::string filename = "packetreader_truncated_test";
+    for(std::string const & data : {std::string("\xca\x05PGP", 5), std::string("\xcb\xe2PGP", 5)}){
+        {
+            std::ofstream f(filename, std::ios::binary);
+            f << data;
+        }
+
+        std::ifstream f(filename, std::ios::binary);
+        OpenPGP::PacketReader short_skip(f);
+        ASSERT_TRUE(short_skip.next(header));
+        EXPECT_THROW(short_skip.next(header), std::runtime_error);
+    }
+    std::remove(filename.c_str());
+}
+
+TEST(Packet, create){
+
+    EXPECT_THROW(OpenPGP::Packet::create(0),  std::runtime_error);
+    EXPECT_THROW(OpenPGP::Packet::create(15), std::runtime_error);
+    EXPECT_THROW(OpenPGP::Packet::create(64), std::runtime_error);
+
+    for(const uint8_t tag : {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 17, 18, 19, 60, 61, 62, 63}){
+        const OpenPGP::Packet::Tag::Ptr packet = OpenPGP::Packet::create(tag);
+        ASSERT_NE(packet, nullptr);
+        EXPECT_EQ(packet -> get_tag(), tag);
+    }
+}
+
+namespace {
+    class Custom : public OpenPGP::Packet::Tag60 {
+        public:
+            std::string show(const std::size_t, const std::size_t) const{
+                return "custom";
+            }
+    };
+}
+
+TEST(Packet, register_tag){
+
+    EXPECT_THROW(OpenPGP::Packet::register_tag(2, OpenPGP::Packet::make <Custom>), std::runtime_error);
+    EXPECT_THROW(OpenPGP::Packet::register_tag(60, nullptr), std::runtime_error);
+
+    OpenPGP::Packet::register_tag(60, OpenPGP::Packet::make <Custom>);
+
+    OpenPGP::Packet::Tag60 tag60;
+    tag60.set_stream("experimental");
+    const OpenPGP::PGP pgp(tag60.write());
+    ASSERT_EQ(pgp.get_packets().size(), (std::size_t) 1);
+    EXPECT_EQ(pgp.get_packets()[0] -> show(0, 4), "custom");
+    EXPECT_EQ(pgp.get_packets()[0] -> raw(), "experimental");
+
+    OpenPGP::Packet::register_tag(60, OpenPGP::Packet::make <OpenPGP::Packet::Tag60>);
+    EXPECT_NE(OpenPGP::Packet::create(60) -> show(0, 4), "custom");
+}
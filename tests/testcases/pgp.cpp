@@ -1,6 +1,7 @@
 #include <cstdlib>
 #include <ctime>
 #include <sstream>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -279,6 +280,54 @@ TEST(PGP, encrypt_decrypt_symmetric_mdc){
     EXPECT_EQ(message, MESSAGE);
 }
 
+TEST(PGP, read_buffer){
+
+    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Sym::ID::AES256);
+
+    // the encrypted data is kept as a slice of the buffer
+    const OpenPGP::Buffer::Ptr buffer = OpenPGP::Buffer::own(encrypted.write(OpenPGP::PGP::Armored::NO));
+    OpenPGP::PGP pgp;
+    pgp.read(buffer);
+    EXPECT_EQ(pgp.get_armored(), false);
+    EXPECT_GT(buffer.use_count(), 1);
+
+    const OpenPGP::Message message(pgp);
+    EXPECT_EQ(message.raw(), encrypted.raw());
+
+    // armored data is decoded first
+    OpenPGP::PGP armored;
+    armored.read(OpenPGP::Buffer::own(encrypted.write(OpenPGP::PGP::Armored::YES)));
+    EXPECT_EQ(armored.get_armored(), true);
+    EXPECT_EQ(armored.raw(), encrypted.raw());
+
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(message, PASSPHRASE);
+    std::string out = "";
+    for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+        if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+            out += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+        }
+    }
+    EXPECT_EQ(out, MESSAGE);
+}
+
+TEST(PGP, write_stream){
+
+    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Hash::ID::SHA256);
+
+    // packets are written to the stream one at a time
+    std::stringstream binary;
+    encrypted.write(binary, OpenPGP::PGP::Armored::NO);
+    EXPECT_EQ(binary.str(), encrypted.raw());
+
+    std::stringstream armored;
+    encrypted.write(armored, OpenPGP::PGP::Armored::YES);
+    const OpenPGP::Message message(armored.str());
+    EXPECT_EQ(message.get_armored(), true);
+    EXPECT_EQ(message.raw(), encrypted.raw());
+}
+
 TEST(PGP, encrypt_decrypt_symmetric_no_mdc){
 
     OpenPGP::Encrypt::Args encrypt_args;
@@ -305,6 +354,33 @@ TEST(PGP, encrypt_decrypt_symmetric_no_mdc){
     EXPECT_EQ(message, MESSAGE);
 }
 
+TEST(PGP, encrypt_decrypt_symmetric_threads){
+
+    // uncompressed, so the encrypted body is large enough to be split across threads
+    std::string big(OpenPGP::CFB_PARALLEL_THRESHOLD + 12345, 0);
+    for(std::size_t i = 0; i < big.size(); i++){
+        big[i] = static_cast <char> (i * 31 + (i >> 8));
+    }
+
+    for(bool const mdc : {true, false}){
+        const OpenPGP::Encrypt::Args encrypt_args("", big, OpenPGP::Sym::ID::AES256, OpenPGP::Compression::ID::UNCOMPRESSED, mdc);
+        const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Hash::ID::SHA256);
+        EXPECT_EQ(encrypted.meaningful(), true);
+
+        // all hardware threads, and more threads than this machine may have
+        for(unsigned int const threads : {0U, 4U}){
+            const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(encrypted, PASSPHRASE, threads);
+            std::string message = "";
+            for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+                if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+                    message += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+                }
+            }
+            EXPECT_EQ(message, big);
+        }
+    }
+}
+
 TEST(PGP, encrypt_sign_decrypt_verify){
 
     OpenPGP::SecretKey pri;
@@ -384,6 +460,130 @@ TEST(PGP, verify_primary_key){
     EXPECT_EQ(OpenPGP::Verify::primary_key(pri, pri), true);
 }
 
+TEST(PGP, arena){
+
+    std::weak_ptr <OpenPGP::Arena> weak;
+    {
+        OpenPGP::PublicKey pub;
+        {
+            const OpenPGP::Arena::Ptr arena = std::make_shared <OpenPGP::Arena> ();
+            weak = arena;
+
+            OpenPGP::Arena::Scope scope(arena);
+            ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", pub), true);
+            EXPECT_GT(arena -> get_used(), (std::size_t) 0);
+        }
+
+        // packets and subpackets keep the arena alive after the scope ends
+        EXPECT_EQ(OpenPGP::Arena::current(), nullptr);
+        ASSERT_EQ(weak.expired(), false);
+
+        const OpenPGP::PublicKey copy(pub);
+        OpenPGP::PublicKey heap;
+        ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", heap), true);
+        EXPECT_EQ(pub.raw(), heap.raw());
+        EXPECT_EQ(OpenPGP::Verify::primary_key(pub, pub), true);
+    }
+
+    // the whole graph is released at once
+    EXPECT_EQ(weak.expired(), true);
+}
+
+TEST(PGP, lazy){
+
+    OpenPGP::PublicKey eager;
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", eager), true);
+
+    OpenPGP::PublicKey lazy;
+    lazy.set_lazy(true);
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", lazy), true);
+    EXPECT_EQ(lazy.keyid(), eager.keyid());
+
+    // signatures that have not been looked at are written back unchanged
+    std::size_t undecoded = 0;
+    for(OpenPGP::Packet::Tag::Ptr const & p : lazy.get_packets()){
+        if (p -> get_tag() == OpenPGP::Packet::SIGNATURE){
+            undecoded += !p -> is_decoded();
+        }
+        else{
+            EXPECT_EQ(p -> is_decoded(), true);
+        }
+    }
+    EXPECT_GT(undecoded, (std::size_t) 0);
+    EXPECT_EQ(lazy.raw(), eager.raw());
+    EXPECT_EQ(lazy.list_keys(), eager.list_keys());
+
+    // copies share the undecoded body
+    const OpenPGP::PublicKey copy(lazy);
+    EXPECT_EQ(copy.get_lazy(), true);
+
+    for(OpenPGP::Packet::Tag::Ptr const & p : copy.get_packets()){
+        if (p -> get_tag() == OpenPGP::Packet::SIGNATURE){
+            const OpenPGP::Packet::Tag2::Ptr sig = std::static_pointer_cast <OpenPGP::Packet::Tag2> (p);
+            EXPECT_EQ(sig -> get_keyid(), eager.keyid());
+            EXPECT_EQ(sig -> is_decoded(), true);
+        }
+    }
+    EXPECT_EQ(copy.show(), OpenPGP::PublicKey(eager).show());
+    EXPECT_EQ(copy.raw(), eager.raw());
+    EXPECT_EQ(OpenPGP::Verify::primary_key(copy, copy), true);
+
+    // a malformed body is only reported once it is decoded
+    OpenPGP::Packet::Tag2 bad;
+    bad.read_lazy(OpenPGP::Slice("\x03\x04\x13" + std::string(14, 0)));
+    EXPECT_EQ(bad.get_version(), 3);
+    EXPECT_EQ(bad.get_type(), 0x13);
+    EXPECT_THROW(bad.get_keyid(), std::runtime_error);
+    EXPECT_EQ(bad.is_decoded(), false);
+
+    // unless the fixed position fields are missing
+    EXPECT_THROW(bad.read_lazy(OpenPGP::Slice(std::string("\x05", 1))), std::runtime_error);
+    EXPECT_ANY_THROW(bad.read_lazy(OpenPGP::Slice(std::string("\x04\x13", 2))));
+
+    // assigning an undecoded v3 signature drops the subpackets of a decoded v4 one
+    OpenPGP::Packet::Tag2 v4(std::string("\x04\x13\x01\x02\x00\x06\x05\x02\x00\x00\x00\x01\x00\x00\xab\xcd\x00\x01\x01", 19));
+    ASSERT_EQ(v4.get_hashed_subpackets().size(), 1U);
+    OpenPGP::Packet::Tag2 v3;
+    v3.read_lazy(OpenPGP::Slice(std::string("\x03\x05\x13\x00\x00\x00\x01" "01234567" "\x01\x02\xab\xcd\x00\x01\x01", 22)));
+    ASSERT_EQ(v3.is_decoded(), false);
+    v4 = v3;
+    EXPECT_EQ(v4.get_version(), 3);
+    EXPECT_EQ(v4.get_keyid(), "01234567");
+    EXPECT_EQ(v4.get_hashed_subpackets().size(), 0U);
+    EXPECT_EQ(v4.get_unhashed_subpackets().size(), 0U);
+}
+
+TEST(PGP, lazy_threads){
+
+    OpenPGP::PublicKey key;
+    key.set_lazy(true);
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", key), true);
+
+    // shared packets may be decoded from several threads at once
+    std::vector <std::thread> threads;
+    std::vector <std::string> shown(4);
+    for(std::size_t i = 0; i < shown.size(); i++){
+        threads.emplace_back([&key, &shown, i](){
+            for(OpenPGP::Packet::Tag::Ptr const & p : key.get_packets()){
+                if (p -> get_tag() == OpenPGP::Packet::SIGNATURE){
+                    shown[i] += std::static_pointer_cast <OpenPGP::Packet::Tag2> (p) -> get_keyid();
+                }
+            }
+            shown[i] += key.raw();
+        });
+    }
+    for(std::thread & t : threads){
+        t.join();
+    }
+
+    OpenPGP::PublicKey eager;
+    ASSERT_EQ(read_pgp <OpenPGP::PublicKey> ("Alicepub", eager), true);
+    for(std::string const & s : shown){
+        EXPECT_EQ(s, shown[0]);
+    }
+    EXPECT_EQ(key.show(), eager.show());
+}
+
 TEST(Key, get_pkey){
     OpenPGP::Key::Ptr k (new OpenPGP::Key(arm));
     OpenPGP::Key::pkey pk = k->get_pkey();
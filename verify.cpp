@@ -364,7 +364,7 @@ int revoke(const Key & key, const RevocationCertificate & revoke){
 
     // if the revocation signature is revoking the primary key
     if (revoke_sig -> get_type() == Signature_Type::KEY_REVOCATION_SIGNATURE){
-        return with_pka(Hash::use(revoke_sig -> get_hash(), addtrailer(overkey(std::static_pointer_cast <Packet::Key> (key.get_packets()[0])), revoke_sig)), signing_key, revoke_sig);
+        return with_pka(hash_with_trailer(revoke_sig, overkey(std::static_pointer_cast <Packet::Key> (key.get_packets()[0]))), signing_key, revoke_sig);
     }
     else if (revoke_sig -> get_type() == Signature_Type::SUBKEY_REVOCATION_SIGNATURE){
         // search each packet for a subkey